@@ -287,7 +287,7 @@ static void kymera_dsp_msg_handler(MessageFromOperator *op_msg)
     {
         case KYMERA_OP_MSG_ID_TONE_END:
             DEBUG_LOG("KYMERA_OP_MSG_ID_TONE_END");
-            appKymeraTonePromptStop();
+            appKymeraTonePromptEnded();
         break;
 
         default:
@@ -310,7 +310,7 @@ static void kymera_msg_handler(Task task, MessageId id, Message msg)
 
         case MESSAGE_STREAM_DISCONNECT:
             DEBUG_LOG("appKymera MESSAGE_STREAM_DISCONNECT");
-            appKymeraTonePromptStop();
+            appKymeraTonePromptEnded();
         break;
 
         case KYMERA_INTERNAL_A2DP_START:
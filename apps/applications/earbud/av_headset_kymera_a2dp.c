@@ -608,6 +608,7 @@ void appKymeraHandleInternalA2dpStop(const KYMERA_INTERNAL_A2DP_STOP_T *msg)
                 appKymeraA2dpCommonStop(msg->source);
                 theKymera->output_rate = 0;
                 theKymera->a2dp_seid = AV_SEID_INVALID;
+                appKymeraTonePromptCacheFlush();
                 theKymera->state = KYMERA_STATE_IDLE;
             break;
             case KYMERA_STATE_IDLE:
@@ -275,6 +275,23 @@ typedef struct
 /*! \brief Immediately stop playing the tone or prompt */
 void appKymeraTonePromptStop(void);
 
+/*! \brief Stop the tone or prompt once it has played to its end.
+
+    As appKymeraTonePromptStop(), but the chain may be kept for the next tone
+    or prompt, see appKymeraTonePromptCacheFlush().
+*/
+void appKymeraTonePromptEnded(void);
+
+/*! \brief Destroy the tone and prompt chains kept for reuse.
+
+    Tone and prompt chains that played to their end while another chain keeps
+    the DSP running are kept, so the next tone or prompt can start without
+    creating them. Chains of tones and prompts that are cut off are destroyed,
+    as their buffers still hold the rest of the tone or prompt. Kept chains
+    must be destroyed before Kymera returns to idle, to let the DSP power off.
+*/
+void appKymeraTonePromptCacheFlush(void);
+
 /*! \brief Create and configure the audio output chain.
     \param rate The sample rate in Hz.
     \param kick_period The kymera kick period.
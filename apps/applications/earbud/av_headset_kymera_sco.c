@@ -481,6 +481,8 @@ void appKymeraHandleInternalScoStop(void)
     /*! \todo Check if MIC_BIAS different for 2 mic */
     MicbiasConfigure(MIC_BIAS_0, MIC_BIAS_ENABLE, MIC_BIAS_OFF);
 
+    appKymeraTonePromptCacheFlush();
+
     /* Update state variables */
     theKymera->state = KYMERA_STATE_IDLE;
     theKymera->output_rate = 0;
@@ -756,6 +758,8 @@ void appKymeraHandleInternalScoForwardingStopRx(void)
     /*! \todo Check if MIC_BIAS different for 2 mic */
     MicbiasConfigure(MIC_BIAS_0, MIC_BIAS_ENABLE, MIC_BIAS_OFF);
 
+    appKymeraTonePromptCacheFlush();
+
     /* Update state variables */
     theKymera->state = KYMERA_STATE_IDLE;
     theKymera->output_rate = 0;
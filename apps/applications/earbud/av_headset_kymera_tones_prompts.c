@@ -186,7 +186,12 @@ void appKymeraHandleInternalTonePromptPlay(const KYMERA_INTERNAL_TONE_PROMPT_PLA
     theKymera->tone_client_lock_mask = msg->client_lock_mask;
 }
 
-void appKymeraTonePromptStop(void)
+/*! \brief Stop playing the tone or prompt.
+    \param ended TRUE if the tone or prompt played to its end. Only then is
+    its chain kept for reuse, as a chain cut off part way through still holds
+    the rest of the tone or prompt in its buffers.
+*/
+static void appKymeraTonePromptStopPlaying(bool ended)
 {
     kymeraTaskData *theKymera = appGetKymera();
 
@@ -194,7 +199,7 @@ void appKymeraTonePromptStop(void)
     if (!theKymera->chain_tone_handle && !theKymera->prompt_source)
         return;
 
-    DEBUG_LOGF("appKymeraTonePromptStop, state %u", theKymera->state);
+    DEBUG_LOGF("appKymeraTonePromptStopPlaying, state %u, ended %u", theKymera->state, ended);
 
     switch (theKymera->state)
     {
@@ -218,7 +223,18 @@ void appKymeraTonePromptStop(void)
             if (theKymera->chain_tone_handle)
             {
                 ChainStop(theKymera->chain_tone_handle);
-                ChainDestroy(theKymera->chain_tone_handle);
+                if (ended && theKymera->state != KYMERA_STATE_TONE_PLAYING)
+                {
+                    /* The DSP stays on for the SCO or A2DP chain, so keep the
+                    tone/prompt chain for the next tone or prompt. When idle the
+                    DSP is turned off, so the chain isn't kept then. */
+                    StreamDisconnect(ChainGetOutput(theKymera->chain_tone_handle, EPR_TONE_PROMPT_CHAIN_OUT), NULL);
+                    ChainCacheStore(theKymera->chain_tone_handle);
+                }
+                else
+                {
+                    ChainDestroy(theKymera->chain_tone_handle);
+                }
                 theKymera->chain_tone_handle = NULL;
             }
 
@@ -236,6 +252,7 @@ void appKymeraTonePromptStop(void)
                 ChainStop(theKymera->chainu.output_vol_handle);
                 ChainDestroy(theKymera->chainu.output_vol_handle);
                 theKymera->chainu.output_vol_handle = NULL;
+                appKymeraTonePromptCacheFlush();
                 /* Move back to idle state */
                 theKymera->state = KYMERA_STATE_IDLE;
                 theKymera->output_rate = 0;
@@ -246,7 +263,7 @@ void appKymeraTonePromptStop(void)
         case KYMERA_STATE_IDLE:
         default:
             /* Unknown state / not supported */
-            DEBUG_LOGF("appKymeraTonePromptStop, unsupported state %u", theKymera->state);
+            DEBUG_LOGF("appKymeraTonePromptStopPlaying, unsupported state %u", theKymera->state);
             Panic();
             break;
     }
@@ -261,3 +278,19 @@ void appKymeraTonePromptStop(void)
         theKymera->tone_client_lock_mask = 0;
     }
 }
+
+void appKymeraTonePromptStop(void)
+{
+    appKymeraTonePromptStopPlaying(FALSE);
+}
+
+void appKymeraTonePromptEnded(void)
+{
+    appKymeraTonePromptStopPlaying(TRUE);
+}
+
+void appKymeraTonePromptCacheFlush(void)
+{
+    DEBUG_LOG("appKymeraTonePromptCacheFlush");
+    ChainCacheFlush();
+}
@@ -13,6 +13,7 @@ DESCRIPTION
 #include "chain_path.h"
 #include "chain_connect.h"
 #include "chain_config.h"
+#include "chain_cache.h"
 
 #include <vmal.h> 
 #include <panic.h>
@@ -194,6 +195,19 @@ kymera_chain_handle_t ChainCreate(const chain_config_t *config)
 kymera_chain_handle_t ChainCreateWithFilter(const chain_config_t *config, const operator_filters_t* filter)
 {
     kymera_chain_t *chain;
+
+    chain = chainCacheRemoveMatching(config, filter);
+
+    if(chain)
+    {
+        /* Operators and their connections were kept by ChainCacheStore() */
+        chainListAdd(chain);
+        AudioProcessorAddUseCase(config->audio_ucid);
+
+        PRINT(("ChainCreate() %p from cache\n", chain));
+
+        return chain;
+    }
     
     chain = chainAllocateMemory(config, filter);
     
@@ -236,6 +250,42 @@ void ChainDestroy(kymera_chain_handle_t handle)
     }
 }
 
+/******************************************************************************/
+void ChainCacheStore(kymera_chain_handle_t handle)
+{
+    kymera_chain_t *chain = handle;
+    PRINT(("ChainCacheStore() %p\n", chain));
+
+    if(chain != NULL)
+    {
+        if(!chain->connected)
+        {
+            /* Only a chain connected as a whole can be handed out again as
+               it is, ready for ChainConnect() to do nothing */
+            ChainDestroy(chain);
+            return;
+        }
+
+        AudioProcessorRemoveUseCase(chain->config->audio_ucid);
+        chainListRemove(chain);
+        chainCacheAdd(chain);
+    }
+}
+
+/******************************************************************************/
+void ChainCacheFlush(void)
+{
+    kymera_chain_t *chain;
+
+    while((chain = chainCacheRemoveFirst()) != NULL)
+    {
+        PRINT(("ChainCacheFlush() %p\n", chain));
+        destroyOperators(chain);
+        processorsDisable(chain);
+        chainFreeMemory(chain);
+    }
+}
+
 /******************************************************************************/
 Operator ChainGetOperatorByRole(kymera_chain_handle_t handle, unsigned operator_role)
 {
@@ -304,6 +354,12 @@ void ChainConnect(kymera_chain_handle_t handle)
 {
     kymera_chain_t *chain = handle;
     PanicNull(chain);
+
+    if(chain->connected)
+    {
+        /* Reused from the cache, with its connections */
+        return;
+    }
     
     if(chainConfigIsStreamBased(chain))
     {
@@ -313,6 +369,7 @@ void ChainConnect(kymera_chain_handle_t handle)
     {
         chainConnectAllOperators(chain);
     }
+    chain->connected = TRUE;
 }
 
 /******************************************************************************/
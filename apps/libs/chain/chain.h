@@ -679,6 +679,38 @@ kymera_chain_handle_t ChainCreateWithFilter(const chain_config_t *config, const
 */
 void ChainDestroy(kymera_chain_handle_t handle);
 
+/*! \brief Destroy a chain, but keep its operators for the next chain created
+from the same config.
+
+The operators, and the connections ChainConnect() made between them, are kept 
+as they are. The next ChainCreate() or ChainCreateWithFilter() with the same 
+config and filter hands the chain back without creating any operator, and 
+ChainConnect() on it does nothing. This takes most of the set-up time out of 
+starting a chain again.
+
+The chain must be stopped, and disconnected from everything outside it, as for
+ChainDestroy(). Configuration sent to its operators, for example by 
+ChainConfigure(), is kept too; the user must send again whatever it relies on.
+A chain that was not connected with ChainConnect(), for example one connected
+with ChainConnectWithPath() or by its user, is destroyed as by ChainDestroy()
+instead of being kept.
+
+Nothing is reset. The operators keep their internal state, such as filter 
+history and play position, and the buffers of the connections inside the 
+chain keep any data left in them when the chain was stopped. A chain reused 
+after being stopped part way through will start by playing that data. Only 
+store a chain whose data has been fully consumed, or one whose user resets 
+its operators before starting it again.
+
+The audio processors the chain uses are kept running until ChainCacheFlush() 
+is called.
+*/
+void ChainCacheStore(kymera_chain_handle_t handle);
+
+/*! \brief Destroy all chains kept by ChainCacheStore().
+*/
+void ChainCacheFlush(void);
+
 /*! \brief Retrieve an operator by its role.
 */
 Operator ChainGetOperatorByRole(const kymera_chain_handle_t handle, unsigned operator_role);
@@ -0,0 +1,82 @@
+/****************************************************************************
+Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+
+FILE NAME
+    chain_cache.c
+
+DESCRIPTION
+    List of chains kept, with their operators, for reuse
+*/
+
+#include "chain_cache.h"
+
+static kymera_chain_t *chain_cache = NULL;
+
+/******************************************************************************/
+static bool operatorConfigsMatch(const operator_config_t *a, const operator_config_t *b)
+{
+    /* Set-up items are compared by table, as the operators were sent the
+       items of that table when they were created */
+    return (a->capability_id == b->capability_id)
+        && (a->role == b->role)
+        && (a->processor_id == b->processor_id)
+        && (a->priority == b->priority)
+        && (a->setup.num_items == b->setup.num_items)
+        && (a->setup.items == b->setup.items);
+}
+
+/******************************************************************************/
+static bool filtersMatch(const kymera_chain_t *chain, const operator_filters_t *filter)
+{
+    unsigned i;
+
+    if(!filter)
+        return (chain->filters.num_operator_filters == 0);
+
+    if(chain->filters.num_operator_filters != filter->num_operator_filters)
+        return FALSE;
+
+    for(i = 0; i < filter->num_operator_filters; i++)
+    {
+        if(!operatorConfigsMatch(&chain->filters.operator_filters[i], &filter->operator_filters[i]))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/******************************************************************************/
+void chainCacheAdd(kymera_chain_t *chain)
+{
+    chain->next = chain_cache;
+    chain_cache = chain;
+}
+
+/******************************************************************************/
+kymera_chain_t *chainCacheRemoveMatching(const chain_config_t *config, const operator_filters_t *filter)
+{
+    kymera_chain_t **head;
+
+    for (head = &chain_cache; *head != NULL; head = &(*head)->next)
+    {
+        kymera_chain_t *chain = *head;
+
+        if (chain->config == config && filtersMatch(chain, filter))
+        {
+            *head = chain->next;
+            return chain;
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************/
+kymera_chain_t *chainCacheRemoveFirst(void)
+{
+    kymera_chain_t *chain = chain_cache;
+
+    if (chain != NULL)
+    {
+        chain_cache = chain->next;
+    }
+    return chain;
+}
@@ -0,0 +1,29 @@
+/****************************************************************************
+Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+*/
+
+#ifndef CHAIN_CACHE_H_
+#define CHAIN_CACHE_H_
+
+#include "chain_list.h"
+
+/****************************************************************************
+DESCRIPTION
+    Keep a chain, with its operators and internal connections, for reuse
+*/
+void chainCacheAdd(kymera_chain_t *chain);
+
+/****************************************************************************
+DESCRIPTION
+    Take a kept chain created with the same config and filter, or NULL if
+    there is none
+*/
+kymera_chain_t *chainCacheRemoveMatching(const chain_config_t *config, const operator_filters_t *filter);
+
+/****************************************************************************
+DESCRIPTION
+    Take any kept chain, or NULL if there is none
+*/
+kymera_chain_t *chainCacheRemoveFirst(void);
+
+#endif /* CHAIN_CACHE_H_ */
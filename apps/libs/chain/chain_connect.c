@@ -14,34 +14,37 @@ DESCRIPTION
 
 #include "chain_connect.h"
 
+/******************************************************************************/
+static void connectTerminals(Operator source_op, unsigned source_terminal, Operator sink_op, unsigned sink_terminal)
+{
+    Source source = StreamSourceFromOperatorTerminal(source_op, (uint16)(source_terminal));
+    Sink sink = StreamSinkFromOperatorTerminal(sink_op, (uint16)(sink_terminal));
+
+    PanicNull(source);
+    PanicNull(sink);
+    PanicNull(StreamConnect(source, sink));
+}
+
 /******************************************************************************/
 static void connectOperators(kymera_chain_t *chain, const operator_connection_t *connection)
 {
+    /* Look the operators up once for all the terminals they connect */
+    Operator source_op = ChainGetOperatorByRole(chain, connection->source_role);
+    Operator sink_op = ChainGetOperatorByRole(chain, connection->sink_role);
     unsigned i;
+
     for(i = 0; i < connection->number_of_terminals; ++i)
     {
-        chainConnectOperatorTerminals(chain, 
-                                      connection->source_role, 
-                                      connection->first_source_terminal + i,
-                                      connection->sink_role,
-                                      connection->first_sink_terminal + i);
+        connectTerminals(source_op, connection->first_source_terminal + i,
+                         sink_op, connection->first_sink_terminal + i);
     }
 }
 
 /******************************************************************************/
 void chainConnectOperatorTerminals(kymera_chain_t *chain, unsigned source_role, unsigned source_terminal, unsigned sink_role, unsigned sink_terminal)
 {
-    Source source;
-    Sink sink;
-    Operator op;
-    op = ChainGetOperatorByRole(chain, source_role);
-    source = StreamSourceFromOperatorTerminal(op, (uint16)(source_terminal));
-    op = ChainGetOperatorByRole(chain, sink_role);
-    sink = StreamSinkFromOperatorTerminal(op, (uint16)(sink_terminal));
-
-    PanicNull(source);
-    PanicNull(sink);
-    PanicNull(StreamConnect(source, sink));
+    connectTerminals(ChainGetOperatorByRole(chain, source_role), source_terminal,
+                     ChainGetOperatorByRole(chain, sink_role), sink_terminal);
 }
 
 /******************************************************************************/
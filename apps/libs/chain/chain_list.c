@@ -75,5 +75,6 @@ void ChainTestReset(void)
         ChainDestroy(item);
         ChainSetDownloadableCapabilityBundleConfig(NULL);
     }
+    ChainCacheFlush();
 }
 #endif
@@ -22,6 +22,7 @@ struct kymera_chain_tag
     operator_filters_internal_t filters;
     kymera_chain_t *next;
     bool chain_enabled;
+    bool connected;
 };
 
 /****************************************************************************
@@ -135,6 +135,33 @@ typedef struct __tws_packetiser_slave_config
 
 } tws_packetiser_slave_config_t;
 
+/*! Statistics of the TWS master packetiser, see #TwsPacketiserMasterGetStatistics() */
+typedef struct __tws_packetiser_master_statistics
+{
+    /*! Audio frames written to packets */
+    uint32 frames_sent;
+
+    /*! Audio frames dropped for any reason, including those counted below */
+    uint32 frames_dropped;
+
+    /*! Audio frames dropped because they were already past the transmit deadline */
+    uint32 frames_late;
+
+    /*! Packets written to the sink */
+    uint32 packets_sent;
+
+    /*! The estimated rate the sink drains at while it is never empty, in
+        octets per second. This is how fast the Bluetooth subsystem takes
+        packets, not the throughput over the air. Zero until the sink has been
+        non-empty long enough to measure it. */
+    uint32 drain_rate;
+
+    /*! Octets queued in the sink, and the most seen */
+    uint32 queued;
+    uint32 max_queued;
+
+} tws_packetiser_master_statistics_t;
+
 /*! Opaque reference to tws packetiser master. */
 struct __tws_packetiser_master;
 typedef struct __tws_packetiser_master tws_packetiser_master_t;
@@ -196,6 +223,16 @@ tws_packetiser_master_t* TwsPacketiserMasterInit(tws_packetiser_master_config_t
 */ 
 uint32 TwsPacketiserMasterHeaderLength(tws_packetiser_master_t *tp, uint32 number_audio_frames);
 
+/*!
+  @brief Get the statistics of the TWS master packetiser.
+  @param tp The instance.
+  @param stats Filled in with the statistics since the instance was created.
+
+  The statistics only report; they don't change which frames are sent.
+*/
+void TwsPacketiserMasterGetStatistics(tws_packetiser_master_t *tp,
+                                      tws_packetiser_master_statistics_t *stats);
+
 /*!
   @brief Destroy the TWS master packetiser instance.
   @param tp The instance to destroy.
@@ -14,10 +14,21 @@ FILE NAME
 #include <string.h>
 #include <stdlib.h>
 #include <stream.h>
+#include <system_clock.h>
 
 #define TP_INTERNAL_MSG_BASE        (0)
 #define TP_INTERNAL_MSG_PERIOD_MS   (25)
 
+/* The drain rate is held in octets per millisecond with this many fractional bits */
+#define TP_DRAIN_RATE_SHIFT         (4)
+/* Time the sink must stay non-empty for a new drain rate measurement.
+   This and TP_DRAIN_RATE_EMA_SHIFT are first guesses, not yet tuned on a
+   congested link. */
+#define TP_DRAIN_SAMPLE_US          (20 * US_PER_MS)
+/* Each measurement moves the drain rate estimate 1/(2^TP_DRAIN_RATE_EMA_SHIFT)
+   of the way towards it */
+#define TP_DRAIN_RATE_EMA_SHIFT     (3)
+
 typedef enum __tp_internal_msg
 {
     TP_INTERNAL_TX_PACKET_MSG = TP_INTERNAL_MSG_BASE,
@@ -39,6 +50,31 @@ typedef enum __process_header_actions
     DROP,
 } process_header_action_t;
 
+/* Estimate of the state of the queue in the sink the packets are written to.
+   How fast it drains is how fast the Bluetooth subsystem takes packets from
+   it, which follows the forwarding link's throughput under congestion but is
+   not a measure of it. */
+typedef struct __tp_sink_queue
+{
+    /*! Octets the sink holds, learnt from the most space seen in it */
+    uint32 sink_size;
+
+    /*! Octets queued in the sink at the last update */
+    uint32 queued;
+
+    /*! The local time of the last update */
+    rtime_t update_time;
+
+    /*! Octets sent and time spent with the queue never empty, towards the
+        next rate measurement */
+    uint32 sample_octets;
+    uint32 sample_time;
+
+    /*! The rate at which the queue drains, in octets per ms with
+        TP_DRAIN_RATE_SHIFT fractional bits. Zero until first measured. */
+    uint32 drain_rate;
+} tp_sink_queue_t;
+
 struct __tws_packetiser_master
 {
     /*! Task for this instance of the library */
@@ -68,7 +104,11 @@ struct __tws_packetiser_master
     /*! The previous value of this state */
     time_before_ttp_state_t time_before_ttp_state_prev;
 
+    /*! The state of the queue in the sink */
+    tp_sink_queue_t queue;
 
+    /*! Statistics for the client */
+    tws_packetiser_master_statistics_t stats;
 };
 
 static const packet_master_functions_t *packet_funcs[] = {
@@ -110,6 +150,7 @@ static void tpDropAudioFrame(tws_packetiser_master_t *tp, audio_frame_metadata_t
 
     tp->packet.funcs->droppedAudioFrame(&tp->packet, frame_src, frame_len, fmd);
     SourceDrop(tp->config.source, frame_len);
+    tp->stats.frames_dropped++;
 }
 
 static bool tpSourceHasEnoughDataToFillPacket(tws_packetiser_master_t *tp)
@@ -118,6 +159,73 @@ static bool tpSourceHasEnoughDataToFillPacket(tws_packetiser_master_t *tp)
     return SourceSize(tp->config.source) >= (tp->config.mtu - header_length);
 }
 
+/* Get the number of octets queued in the sink waiting to be sent */
+static uint32 tpSinkQueued(tws_packetiser_master_t *tp)
+{
+    uint16 claimed = SinkClaim(tp->config.sink, 0);
+    uint32 space = SinkSlack(tp->config.sink);
+
+    if (claimed != 0xFFFF)
+    {
+        space += claimed;
+    }
+    if (space > tp->queue.sink_size)
+    {
+        tp->queue.sink_size = space;
+    }
+    return tp->queue.sink_size - space;
+}
+
+/* Measure how much of the queue has drained since the last update.
+   Only time when the queue was never empty says how fast it drains, any
+   other time only gives a lower bound on the rate. */
+static void tpSinkQueueUpdate(tws_packetiser_master_t *tp)
+{
+    tp_sink_queue_t *queue = &tp->queue;
+    rtime_t now = SystemClockGetTimerTime();
+    uint32 queued = tpSinkQueued(tp);
+    uint32 elapsed = rtime_sub(now, queue->update_time);
+    uint32 sent = (queue->queued > queued) ? (queue->queued - queued) : 0;
+
+    if (queue->queued && elapsed)
+    {
+        if (queued)
+        {
+            queue->sample_octets += sent;
+            queue->sample_time += elapsed;
+            if (queue->sample_time >= TP_DRAIN_SAMPLE_US)
+            {
+                uint32 rate = (queue->sample_octets << TP_DRAIN_RATE_SHIFT) * US_PER_MS / queue->sample_time;
+                if (queue->drain_rate)
+                {
+                    queue->drain_rate = (int32)queue->drain_rate + (((int32)rate - (int32)queue->drain_rate) >> TP_DRAIN_RATE_EMA_SHIFT);
+                }
+                else
+                {
+                    queue->drain_rate = rate;
+                }
+                queue->sample_octets = queue->sample_time = 0;
+                TP_DEBUG2("TPMASTER: drain rate %d queued %d", queue->drain_rate, queued);
+            }
+        }
+        else
+        {
+            uint32 rate = (sent << TP_DRAIN_RATE_SHIFT) * US_PER_MS / elapsed;
+            if (rate > queue->drain_rate)
+            {
+                queue->drain_rate = rate;
+            }
+            queue->sample_octets = queue->sample_time = 0;
+        }
+    }
+    queue->queued = queued;
+    queue->update_time = now;
+    if (queued > tp->stats.max_queued)
+    {
+        tp->stats.max_queued = queued;
+    }
+}
+
 static time_before_ttp_state_t tpClassifyTimeBeforeTTP(tws_packetiser_master_t *tp, rtime_t ttp)
 {
     time_before_ttp_state_t state;
@@ -155,6 +263,7 @@ static process_header_action_t tpDecideAction(tws_packetiser_master_t *tp, rtime
 
         case TIME_BEFORE_TTP_LATE:
         default:
+            tp->stats.frames_late++;
             action = DROP;
         break;
     }
@@ -173,6 +282,8 @@ static bool tpProcessHeader(tws_packetiser_master_t *tp)
        message - it will be re-sent if necessary */
     PanicFalse(MessageCancelAll(&tp->lib_task, TP_INTERNAL_TX_PACKET_MSG) <= 1);
 
+    tpSinkQueueUpdate(tp);
+
     while (PacketiserHelperAudioFrameMetadataGetFromSource(tp->config.source, &fmd))
     {
         process_header_action_t action = tpDecideAction(tp, fmd.ttp);
@@ -223,6 +334,7 @@ static void tpWriteFrames(tws_packetiser_master_t *tp)
         if (tp->packet.funcs->writeAudioFrame(&tp->packet, frame_src, frame_len, &fmd))
         {
             SourceDrop(tp->config.source, frame_len);
+            tp->stats.frames_sent++;
             TP_DEBUG2("TPMASTER:    Wrote Frame: %d %d", fmd.ttp, frame_len);
         }
         else
@@ -239,6 +351,8 @@ static void tpTransmitPacket(tws_packetiser_master_t *tp)
     tp->packet.funcs->finalise(&tp->packet);
     packet_len = tp->packet.funcs->packetLength(&tp->packet);
     PanicFalse(SinkFlush(tp->config.sink, packet_len));
+    tp->queue.queued += packet_len;
+    tp->stats.packets_sent++;
     TP_DEBUG3("TPMASTER: Transmitted packet with TTP 0x%x, %d, %d",
                 tp->ttp_wallclock, RtimeTimeBeforeTTP(tp->ttp_local), packet_len);
 }
@@ -298,6 +412,7 @@ tws_packetiser_master_t* TwsPacketiserMasterInit(tws_packetiser_master_config_t
 
                 tp->time_before_ttp_state_prev = TIME_BEFORE_TTP_EARLY;
                 tp->first_packet = TRUE;
+                tp->queue.update_time = SystemClockGetTimerTime();
 
                 MessageStreamTaskFromSink(config->sink, &tp->lib_task);
                 MessageStreamTaskFromSource(config->source, &tp->lib_task);
@@ -325,6 +440,14 @@ uint32 TwsPacketiserMasterHeaderLength(tws_packetiser_master_t *tp, uint32 numbe
     return tp->packet.funcs->headerLength(&tp->packet, number_audio_frames);
 }
 
+void TwsPacketiserMasterGetStatistics(tws_packetiser_master_t *tp,
+                                      tws_packetiser_master_statistics_t *stats)
+{
+    *stats = tp->stats;
+    stats->drain_rate = (tp->queue.drain_rate * MS_PER_SEC) >> TP_DRAIN_RATE_SHIFT;
+    stats->queued = tp->queue.queued;
+}
+
 void TwsPacketiserMasterDestroy(tws_packetiser_master_t *tp)
 {
     uint32 i;
@@ -17,12 +17,30 @@ DESCRIPTION
 #include"voice_assistant_packetiser_private.h"
 #include"voice_assistant_packet_send.h"
 
-#define MIN_VA_PACKET_TO_SEND 2
-#define VA_VOICE_PKT_LEN 64
-#define MIN_VA_PKT_SIZE_TO_BE_SEND (VA_VOICE_PKT_LEN*MIN_VA_PACKET_TO_SEND)
+/* Number of voice frames that fill one GAIA packet */
+#define VAP_FRAMES_PER_PACKET (GAIA_MAX_PAYLOAD / VA_VOICE_PKT_LEN)
 
 /* PRIVATE FUNCTION DEFINITIONS **********************************************/
 
+/******************************************************************************
+DESCRIPTION
+    @brief Send voice frames to GAIA and count them.
+
+    @return The number of frames sent.
+*/
+static uint16 vapSendFrames(voice_assistant_packetiser_t *vap, const uint8 *data, uint16 frames)
+{
+    uint16 sent_frames = GaiaVoiceAssistantSendData(frames * VA_VOICE_PKT_LEN, data, frames) / VA_VOICE_PKT_LEN;
+
+    vap->stats.frames_sent += sent_frames;
+    /* GAIA does not report the packets it flushes, so estimate them */
+    vap->stats.packets_sent += (sent_frames + VAP_FRAMES_PER_PACKET - 1) / VAP_FRAMES_PER_PACKET;
+
+    PRINT(("VAP: Frames Sent[%u] of [%u]\n", sent_frames, frames));
+
+    return sent_frames;
+}
+
 /* PUBLIC FUNCTION DEFINITIONS ***********************************************/
 
 /******************************************************************************
@@ -30,30 +48,53 @@ DESCRIPTION
     @brief This function reads voice data packets from the source and send to 
               the remote device through GAIA library.
 
-    @param src The DSP encoded voice samples data to be read.
+    @param vap The voice assistant packetiser instance.
+    @param flush Send a part filled packet too.
 */
-void VapSendPacket(Source src)
+void VapSendPacket(voice_assistant_packetiser_t *vap, bool flush)
 {
+    Source src = vap->source;
     const uint8 *payload = SourceMap(src);
-    uint16 sent_packet_size = 0;
+    uint16 queued = 0;
 
     PRINT(("VAP: VapSendPacket() \n"));
 
     if(payload)
     {
-        uint16 packet_len = SourceSize(src);
+        uint16 frames = SourceSize(src) / VA_VOICE_PKT_LEN;
 
-        PRINT(("VAP: Length[%u] and Source[%p]\n", packet_len, payload));
+        /* Send whole packets only, the rest waits for more frames */
+        if (!flush)
+        {
+            frames -= frames % VAP_FRAMES_PER_PACKET;
+        }
+
+        PRINT(("VAP: Frames[%u] and Source[%p]\n", frames, payload));
 
-        /* Check enough packets are there to send */
-        if((packet_len) && (packet_len >= MIN_VA_PKT_SIZE_TO_BE_SEND))
+        if (frames)
         {
-            /* Send VA packet to GAIA library. */
-            sent_packet_size = GaiaVoiceAssistantSendData(packet_len, payload,(packet_len/VA_VOICE_PKT_LEN));
-            /* Drop the processed packet data. */
-            SourceDrop(src, sent_packet_size);
-            PRINT(("VAP: Packet Sent: Lenth[%u]\n",sent_packet_size));
+            uint16 sent_frames = vapSendFrames(vap, payload, frames);
+
+            /* Drop the processed packet data. Frames GAIA did not take stay
+               in the source, so the DSP is held back until they are sent. */
+            SourceDrop(src, sent_frames * VA_VOICE_PKT_LEN);
         }
+
+        queued = SourceSize(src) / VA_VOICE_PKT_LEN;
+    }
+
+    vap->stats.queued = queued;
+    if (queued > vap->stats.max_queued)
+    {
+        vap->stats.max_queued = queued;
+    }
+
+    /* Make sure a part filled packet, or frames that could not be sent,
+       do not wait long for more voice data to arrive */
+    if (queued && !vap->flush_pending)
+    {
+        vap->flush_pending = TRUE;
+        MessageSendLater(&vap->lib_task, VAP_INTERNAL_FLUSH_MSG, NULL, VAP_FLUSH_DELAY_MS);
     }
 }
 
@@ -15,14 +15,21 @@ DESCRIPTION
 #ifndef __VOICE_ASSISTANT_PACKET_SEND_H__
 #define __VOICE_ASSISTANT_PACKET_SEND_H__
 
+#include "voice_assistant_packetiser_private.h"
+
 /******************************************************************************
 DESCRIPTION
     @brief This function reads voice data packets from the source and send to 
               the remote device through GAIA library.
 
-    @param src The DSP encoded voice samples data will be read.
+    Frames are sent in whole GAIA packets, unless flush is set, so a frame
+    can wait up to VAP_FLUSH_DELAY_MS for the rest of its packet.
+    Frames GAIA cannot take are left in the source and retried.
+
+    @param vap The voice assistant packetiser instance.
+    @param flush Send a part filled packet too.
 */
-void VapSendPacket(Source src);
+void VapSendPacket(voice_assistant_packetiser_t *vap, bool flush);
 
 #endif  /* __VOICE_ASSISTANT_PACKET_SEND_H__ */
 
@@ -14,6 +14,7 @@ DESCRIPTION
 #include <message.h>
 #include <panic.h>
 #include <vmal.h>
+#include <vm.h>
 
 #include"voice_assistant_packetiser_private.h"
 #include "voice_assistant_packetiser.h"
@@ -45,11 +46,19 @@ static void VaPacketiserMessageHandler(Task task, MessageId id, Message message)
         {
             if(NULL != voice_assistant_packetiser->source)/* Use SourceIsValid() once B-231645 is fixed. TO DO. */
             {
-                VapSendPacket(((MessageMoreData *) message)->source);
+                VapSendPacket(voice_assistant_packetiser, FALSE);
             }
         }
         break;
 
+        /* Voice data has waited long enough for a packet to fill. */
+        case VAP_INTERNAL_FLUSH_MSG:
+        {
+            voice_assistant_packetiser->flush_pending = FALSE;
+            VapSendPacket(voice_assistant_packetiser, TRUE);
+        }
+        break;
+
         default:
             PRINT(("VAP: Unhandled message %x\n", id));
             break;
@@ -82,6 +91,7 @@ bool VaPacketiserStart(Source source)
 
             /* Store DSP encoded voice samples data source. */
             voice_assistant_packetiser->source = source;
+            voice_assistant_packetiser->start_time = VmGetClock();
 
             /* Set the handler function */
             voice_assistant_packetiser->lib_task.handler = VaPacketiserMessageHandler;
@@ -94,7 +104,7 @@ bool VaPacketiserStart(Source source)
 
             /* Initial read is need for the source, otherwise MESSAGE_MORE_DATA may not be sent.
                Without MESSAGE_MORE_DATA this library won't process any data. */
-            VapSendPacket(voice_assistant_packetiser->source);
+            VapSendPacket(voice_assistant_packetiser, FALSE);
 
             return TRUE;
         }
@@ -136,6 +146,10 @@ bool VaPacketiserStop(void)
         /* Clear pending messages */
         MessageFlushTask(&voice_assistant_packetiser->lib_task);
 
+        PRINT(("VAP: Sent[%lu] Max queued[%u]\n",
+               voice_assistant_packetiser->stats.frames_sent,
+               voice_assistant_packetiser->stats.max_queued));
+
         free(voice_assistant_packetiser);
         voice_assistant_packetiser = NULL;
         return TRUE;
@@ -144,3 +158,25 @@ bool VaPacketiserStop(void)
     return FALSE;
 }
 
+/******************************************************************************
+DESCRIPTION
+    @brief API function to the application for reading the counters of the
+    voice assistant packetiser.
+
+    @param stats Filled in with the counters since VaPacketiserStart().
+
+    @return TRUE on success, FALSE if the packetiser is not running.
+*/
+bool VaPacketiserGetStatistics(va_packetiser_statistics_t *stats)
+{
+    if(voice_assistant_packetiser)
+    {
+        uint32 elapsed = VmGetClock() - voice_assistant_packetiser->start_time;
+
+        *stats = voice_assistant_packetiser->stats;
+        stats->packets_per_second = elapsed ? (uint16)((stats->packets_sent * 1000) / elapsed) : 0;
+        return TRUE;
+    }
+
+    return FALSE;
+}
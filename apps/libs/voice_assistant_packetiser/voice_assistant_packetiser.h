@@ -24,6 +24,29 @@ DESCRIPTION
 
 #include <source_.h>
 
+/******************************************************************************
+DESCRIPTION
+    @brief Counters of the voice assistant packetiser.
+*/
+typedef struct
+{
+    /*! GAIA voice data packets sent. This is an estimate: GAIA does not say
+        how it packs the frames it takes, so each send is counted as the
+        number of full packets its frames would fill, rounded up. */
+    uint32 packets_sent;
+
+    /*! Voice frames sent */
+    uint32 frames_sent;
+
+    /*! Average of the packets_sent estimate per second since the start */
+    uint16 packets_per_second;
+
+    /*! Voice frames waiting in the source to be sent, and the most seen */
+    uint16 queued;
+    uint16 max_queued;
+
+} va_packetiser_statistics_t;
+
 /******************************************************************************
 DESCRIPTION
     @brief API function to the application for Creating the instance and initialise
@@ -44,5 +67,16 @@ DESCRIPTION
 */
 bool VaPacketiserStop(void);
 
+/******************************************************************************
+DESCRIPTION
+    @brief API function to the application for reading the counters of the
+    voice assistant packetiser.
+
+    @param stats Filled in with the counters since VaPacketiserStart().
+
+    @return TRUE on success, FALSE if the packetiser is not running.
+*/
+bool VaPacketiserGetStatistics(va_packetiser_statistics_t *stats);
+
 #endif /* ifdef _VOICE_ASSISTANT_PACKETISER_H_ */
 
@@ -23,10 +23,25 @@ DESCRIPTION
 
 #include "app/message/system_message.h"
 
+#include "voice_assistant_packetiser.h"
+
 /*****************************************************************************/
 
 /*-------------------  Defines -------------------*/
 
+/* Length of one encoded voice frame */
+#define VA_VOICE_PKT_LEN 64
+
+/* Longest time a part filled packet, or frames GAIA did not take, wait
+   before being sent */
+#define VAP_FLUSH_DELAY_MS 15
+
+/* Internal messages */
+typedef enum
+{
+    VAP_INTERNAL_FLUSH_MSG
+} vap_internal_msg_t;
+
 /******************************************************************************
 DESCRIPTION
     @brief voice assistant packetiser library main task and its data members.
@@ -40,6 +55,15 @@ typedef struct __voice_assistant_packetiser
     /*! The Source of voice data captured from DSP. */
     Source source;
 
+    /*! Set while a VAP_INTERNAL_FLUSH_MSG is pending */
+    bool flush_pending;
+
+    /*! The time the packetiser started, in ms */
+    uint32 start_time;
+
+    /*! Counters for the client */
+    va_packetiser_statistics_t stats;
+
 }voice_assistant_packetiser_t;
 
 #endif /* ifdef _VOICE_ASSISTANT_PACKETISER_PRIVATE_H_ */
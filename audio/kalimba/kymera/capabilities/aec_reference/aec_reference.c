@@ -164,6 +164,13 @@ bool aec_reference_create(OPERATOR_DATA *op_data, void *message_data, unsigned *
     op_extra_data->Cur_mode = AEC_REFERENCE_SYSMODE_FULL;
     op_extra_data->kick_id = TIMER_ID_INVALID;
 
+#ifdef PROFILER_ON
+    /* The path profilers live in the operator data, so the timer task
+     * never has to allocate them. */
+    PROFILER_STATIC_INIT(&op_extra_data->mic_path_profiler, "AecRefMicPath", INT_TO_EXT_OPID(op_data->id));
+    PROFILER_STATIC_INIT(&op_extra_data->spkr_path_profiler, "AecRefSpkrPath", INT_TO_EXT_OPID(op_data->id));
+#endif
+
 #ifdef AEC_REFERENCE_GENERATE_MIC_TIMESTAMP
     /* set minimum tag length for mic output metadata tags */
     op_extra_data->mic_metadata_min_tag_len = AEC_REFERENCE_MIC_METADATA_MIN_TAG_LEN;
@@ -270,6 +277,27 @@ void aec_reference_set_mic_gains(OPERATOR_DATA *op_data)
 cbops_op *insert_op  = NULL;
 cbops_op *st_disgard_op = NULL;
 #endif
+
+#ifdef PROFILER_ON
+/* Run a cbops graph (Y) under one of the path profilers, but only while
+ * the operator itself is being profiled. */
+#define AEC_REFERENCE_PATH_MEASURE(OP_DATA, PROF, Y) \
+    do                                                                  \
+    {                                                                   \
+        if ((OP_DATA)->profiler != NULL)                                \
+        {                                                               \
+            PROFILER_MEASURE(PROF, Y);                                  \
+            (PROF)->kick_inc++;                                         \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            Y;                                                          \
+        }                                                               \
+    }                                                                   \
+    while (0)
+#else
+#define AEC_REFERENCE_PATH_MEASURE(OP_DATA, PROF, Y) Y
+#endif
 /**
  * aec_reference_cleanup
  * \brief clean up the aec-reference operator internal states
@@ -316,6 +344,11 @@ bool aec_reference_destroy(OPERATOR_DATA *op_data, void *message_data, unsigned
     /* Make sure everything is cleared */
     aec_reference_cleanup(op_data);
 
+#ifdef PROFILER_ON
+    PROFILER_DEREGISTER(&op_extra_data->mic_path_profiler);
+    PROFILER_DEREGISTER(&op_extra_data->spkr_path_profiler);
+#endif
+
 #ifdef AEC_REFERENCE_GENERATE_MIC_TIMESTAMP
     /* delete mic time-to-play object */
     if(op_extra_data->mic_time_to_play != NULL)
@@ -3200,7 +3233,8 @@ void aec_reference_timer_task(void *kick_object)
 #endif
 
         {
-            cbops_process_data(op_extra_data->mic_graph, CBOPS_MAX_COPY_SIZE-1);
+            AEC_REFERENCE_PATH_MEASURE(op_data, &op_extra_data->mic_path_profiler,
+                                       cbops_process_data(op_extra_data->mic_graph, CBOPS_MAX_COPY_SIZE-1));
         }
 
 #ifdef AEC_REFERENCE_GENERATE_MIC_TIMESTAMP
@@ -3248,7 +3282,8 @@ void aec_reference_timer_task(void *kick_object)
             }
 
             /* run cbops process */
-            cbops_process_data(op_extra_data->spkr_graph, max_to_process);
+            AEC_REFERENCE_PATH_MEASURE(op_data, &op_extra_data->spkr_path_profiler,
+                                       cbops_process_data(op_extra_data->spkr_graph, max_to_process));
 
             if(met_buf!= NULL && buff_has_metadata(met_buf))
             {
@@ -3288,7 +3323,8 @@ void aec_reference_timer_task(void *kick_object)
                 }
             }
 #else /* AEC_REFERENCE_SUPPORT_METADATA */
-            cbops_process_data(op_extra_data->spkr_graph, CBOPS_MAX_COPY_SIZE-1);
+            AEC_REFERENCE_PATH_MEASURE(op_data, &op_extra_data->spkr_path_profiler,
+                                       cbops_process_data(op_extra_data->spkr_graph, CBOPS_MAX_COPY_SIZE-1));
 #endif /* AEC_REFERENCE_SUPPORT_METADATA*/
 #ifdef PROFILER_ON
             if (op_data->profiler != NULL)
@@ -248,6 +248,10 @@ typedef struct aec_ref_root {
                                               * value of 8.7ms will be used */
     unsigned input_buffer_size;              /* required buffer size for input terminals, if 0 default
                                               * value of 3ms will be used */
+#ifdef PROFILER_ON
+    profiler mic_path_profiler;              /* cost of the mic cbops graph in the timer task */
+    profiler spkr_path_profiler;             /* cost of the speaker cbops graph in the timer task */
+#endif
 } AEC_REFERENCE_OP_DATA;
 
 /****************************************************************************
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  frame_trace.c
+ * \ingroup  capabilities
+ *
+ *  Common functions
+ *  Used by frame based capabilities to record how long each frame took to
+ *  process and how regularly frames arrived, for reporting in their status.
+ */
+
+#include "frame_trace.h"
+#include "op_msg_utilities.h"
+#include "hal/hal_time.h"
+#include <string.h>
+
+#ifdef INSTALL_FRAME_TRACE
+
+/**
+ * \brief Address of a word of the status, in the order
+ *        frame_trace_pack_status sends them.
+ */
+static unsigned *frame_trace_status_word(FRAME_TRACE *trace, unsigned n)
+{
+    unsigned entry;
+
+    switch(n)
+    {
+    case 0:
+        return &trace->frames;
+    case 1:
+        return &trace->nominal_interval;
+    case 2:
+        return &trace->max_proc_time;
+    case 3:
+        return &trace->max_jitter;
+    default:
+        break;
+    }
+
+    /* Two words per frame, oldest frame first */
+    n -= 4;
+    entry = (trace->next + (n >> 1)) % FRAME_TRACE_LENGTH;
+    return (n & 1) ? &trace->interval[entry] : &trace->proc_time[entry];
+}
+
+/**
+ * frame_trace_init
+ */
+void frame_trace_init(FRAME_TRACE *trace, unsigned frame_size, unsigned sample_rate)
+{
+    memset(trace, 0, sizeof(FRAME_TRACE));
+    if(sample_rate != 0)
+    {
+        trace->nominal_interval = (unsigned)(((uint32)frame_size * SECOND) / sample_rate);
+    }
+}
+
+/**
+ * frame_trace_start
+ */
+void frame_trace_start(FRAME_TRACE *trace)
+{
+    trace->start = time_get_time();
+}
+
+/**
+ * frame_trace_stop
+ */
+void frame_trace_stop(FRAME_TRACE *trace)
+{
+    unsigned proc_time = (unsigned)time_sub(time_get_time(), trace->start);
+    unsigned interval = 0;
+
+    if(trace->frames != 0)
+    {
+        int jitter;
+
+        interval = (unsigned)time_sub(trace->start, trace->last_start);
+        jitter = (int)interval - (int)trace->nominal_interval;
+        if(jitter < 0)
+        {
+            jitter = -jitter;
+        }
+        if((unsigned)jitter > trace->max_jitter)
+        {
+            trace->max_jitter = (unsigned)jitter;
+        }
+    }
+    if(proc_time > trace->max_proc_time)
+    {
+        trace->max_proc_time = proc_time;
+    }
+
+    trace->proc_time[trace->next] = proc_time;
+    trace->interval[trace->next] = interval;
+    trace->next = (trace->next + 1) % FRAME_TRACE_LENGTH;
+    trace->last_start = trace->start;
+    trace->frames++;
+}
+
+/**
+ * frame_trace_pack_status
+ */
+unsigned *frame_trace_pack_status(FRAME_TRACE *trace, unsigned *last_word, unsigned *resp)
+{
+    unsigned *first = last_word;
+    unsigned n = 0;
+
+    if(first == NULL)
+    {
+        first = frame_trace_status_word(trace, n++);
+    }
+    while(n < FRAME_TRACE_STATUS_WORDS)
+    {
+        resp = cpsPackWords(first, frame_trace_status_word(trace, n++), resp);
+        first = (n < FRAME_TRACE_STATUS_WORDS) ? frame_trace_status_word(trace, n++) : NULL;
+    }
+    if(first != NULL)
+    {
+        resp = cpsPackWords(first, NULL, resp);
+    }
+
+    trace->max_proc_time = 0;
+    trace->max_jitter = 0;
+
+    return resp;
+}
+
+#endif /* INSTALL_FRAME_TRACE */
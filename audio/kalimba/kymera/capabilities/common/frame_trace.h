@@ -0,0 +1,97 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file  frame_trace.h
+ * \ingroup  capabilities
+ *
+ *  Common functions
+ *  Used by frame based capabilities to record how long each frame took to
+ *  process and how regularly frames arrived, for reporting in their status.
+ *  Only the whole frame is timed, not the modules processing it.
+ *  Built in with config.MODIFY_CVC_FRAME_TRACE (INSTALL_FRAME_TRACE).
+ */
+#ifndef FRAME_TRACE_H
+#define FRAME_TRACE_H
+
+#include "types.h"
+#include "pl_timers/pl_timers.h"
+
+/************************* Public constants and macros ******************* */
+
+/** Number of frames kept in the trace */
+#define FRAME_TRACE_LENGTH          8
+
+/** Number of status words frame_trace_pack_status writes */
+#define FRAME_TRACE_STATUS_WORDS    (4 + 2*FRAME_TRACE_LENGTH)
+
+/***************************** Public types ******************************* */
+
+/** Trace of the latest frames processed by a capability */
+typedef struct
+{
+    /** Time spent processing each of the latest frames, in microseconds */
+    unsigned proc_time[FRAME_TRACE_LENGTH];
+    /** Time from the start of the frame before to the start of each frame,
+     *  in microseconds. 0 for the first frame traced. */
+    unsigned interval[FRAME_TRACE_LENGTH];
+    /** Entry the next frame is recorded in */
+    unsigned next;
+    /** Number of frames traced */
+    unsigned frames;
+    /** Period of a frame, in microseconds */
+    unsigned nominal_interval;
+    /** Longest processing time since the status was last read */
+    unsigned max_proc_time;
+    /** Largest distance of an interval from nominal_interval since the
+     *  status was last read */
+    unsigned max_jitter;
+    /** Start time of the frame being processed */
+    TIME start;
+    /** Start time of the frame before */
+    TIME last_start;
+} FRAME_TRACE;
+
+/***************************** Public functions *************************** */
+
+/**
+ * \brief Clear a trace.
+ *
+ * \param trace The trace
+ * \param frame_size Samples per frame
+ * \param sample_rate Sample rate, in Hz
+ */
+extern void frame_trace_init(FRAME_TRACE *trace, unsigned frame_size, unsigned sample_rate);
+
+/**
+ * \brief Mark the start of processing a frame.
+ *
+ * \param trace The trace
+ */
+extern void frame_trace_start(FRAME_TRACE *trace);
+
+/**
+ * \brief Mark the end of processing a frame and record it.
+ *
+ * \param trace The trace
+ */
+extern void frame_trace_stop(FRAME_TRACE *trace);
+
+/**
+ * \brief Pack the trace into a status response, oldest frame first, and
+ *        restart the maxima.
+ *
+ * The frame count, period and maxima come first, then the processing time
+ * and interval of each frame in turn.
+ *
+ * \param trace The trace
+ * \param last_word The capability's own last status word, packed with the
+ *        first word of the trace as statistics with an odd number of words
+ *        would otherwise pad it. NULL if there isn't one.
+ * \param resp Where to pack the words
+ *
+ * \return Pointer past the packed words
+ */
+extern unsigned *frame_trace_pack_status(FRAME_TRACE *trace, unsigned *last_word, unsigned *resp);
+
+#endif /* FRAME_TRACE_H */
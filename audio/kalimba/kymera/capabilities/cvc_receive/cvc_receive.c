@@ -314,6 +314,10 @@ bool cvc_receive_create(OPERATOR_DATA *op_data, void *message_data, unsigned *re
          op_extra_data->frame_size_out <<= 1;
       }
 
+#ifdef INSTALL_FRAME_TRACE
+      frame_trace_init(&op_extra_data->frame_trace, op_extra_data->frame_size_in, op_extra_data->sample_rate);
+#endif
+
       /*allocate the colume control shared memory*/
       op_extra_data->shared_volume_ptr = allocate_shared_volume_cntrl();
       if(!op_extra_data->shared_volume_ptr)
@@ -722,7 +726,13 @@ void cvc_receive_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched
 #endif
 
     /* call the "process" assembly function */
+#ifdef INSTALL_FRAME_TRACE
+    frame_trace_start(&op_extra_data->frame_trace);
     CVC_RCV_CAP_Process(op_extra_data);
+    frame_trace_stop(&op_extra_data->frame_trace);
+#else
+    CVC_RCV_CAP_Process(op_extra_data);
+#endif
 
     /* touched output */
     touched->sources = TOUCHED_SOURCE_0;
@@ -820,7 +830,12 @@ bool cvc_receive_opmsg_obpm_get_status(OPERATOR_DATA *op_data, void *message_dat
     unsigned  *resp;
     unsigned **stats = (unsigned**)op_extra_data->status_table;
 
+#ifdef INSTALL_FRAME_TRACE
+    if(!common_obpm_status_helper(message_data,resp_length,resp_data,
+                                  sizeof(CVC_RECV_STATISTICS) + FRAME_TRACE_STATUS_WORDS*sizeof(ParamType),&resp))
+#else
     if(!common_obpm_status_helper(message_data,resp_length,resp_data,sizeof(CVC_RECV_STATISTICS),&resp))
+#endif
     {
          return FALSE;
     }
@@ -838,7 +853,12 @@ bool cvc_receive_opmsg_obpm_get_status(OPERATOR_DATA *op_data, void *message_dat
         resp = cpsPackWords(stats[3], stats[4], resp);
         resp = cpsPackWords(stats[5], stats[6], resp);
         resp = cpsPackWords(stats[7], stats[8], resp);
+#ifdef INSTALL_FRAME_TRACE
+        /* Frame trace follows the statistics */
+        frame_trace_pack_status(&op_extra_data->frame_trace, stats[9], resp);
+#else
         cpsPackWords(stats[9], NULL, resp);
+#endif
     }
    
     return TRUE;
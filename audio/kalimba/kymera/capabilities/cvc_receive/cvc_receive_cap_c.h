@@ -17,6 +17,9 @@
 #include "volume/shared_volume_control.h"
 #include "op_msg_utilities.h"
 #include "ps/ps.h"
+#ifdef INSTALL_FRAME_TRACE
+#include "frame_trace.h"
+#endif
 
 /* Capability Version */
 #define CVC_RECIEVE_CAP_VERSION_MINOR            2
@@ -74,6 +77,9 @@ typedef struct
     unsigned sample_rate;
 
     CPS_PARAM_DEF parms_def;
+#ifdef INSTALL_FRAME_TRACE
+    FRAME_TRACE frame_trace;          /**< Processing time and arrival of the latest frames */
+#endif
 } CVC_RECEIVE_OP_DATA;
 
 /****************************************************************************
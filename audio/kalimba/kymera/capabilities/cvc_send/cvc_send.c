@@ -1018,6 +1018,9 @@ static bool cvc_send_config(CVC_SEND_OP_DATA *op_extra_data)
                     op_extra_data->sample_rate = 8000;
                     break;          
                 }
+#ifdef INSTALL_FRAME_TRACE
+                frame_trace_init(&op_extra_data->frame_trace, op_extra_data->frame_size, op_extra_data->sample_rate);
+#endif
                 op_extra_data->ReInitFlag = 1;
                 op_extra_data->Host_mode = CVC_SEND_SYSMODE_FULL;
                 op_extra_data->Cur_mode = CVC_SEND_SYSMODE_STANDBY;
@@ -1536,7 +1539,13 @@ void cvc_send_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
     }
 
     /* call the "process" assembly function */
+#ifdef INSTALL_FRAME_TRACE
+    frame_trace_start(&op_extra_data->frame_trace);
+    CVC_SEND_CAP_Process(op_extra_data);
+    frame_trace_stop(&op_extra_data->frame_trace);
+#else
     CVC_SEND_CAP_Process(op_extra_data);
+#endif
 
     /* touched output */
     touched->sources = TOUCHED_SOURCE_0;
@@ -1716,7 +1725,12 @@ bool cvc_send_opmsg_obpm_get_status(OPERATOR_DATA *op_data, void *message_data,
 
     patch_fn(cvc_send_opmsg_obpm_get_status_patch);
 
+#ifdef INSTALL_FRAME_TRACE
+    if(!common_obpm_status_helper(message_data,resp_length,resp_data,
+                                  sizeof(CVC_SEND_STATISTICS) + FRAME_TRACE_STATUS_WORDS*sizeof(ParamType),&resp))
+#else
     if(!common_obpm_status_helper(message_data,resp_length,resp_data,sizeof(CVC_SEND_STATISTICS),&resp))
+#endif
     {
          return FALSE;
     }
@@ -1737,7 +1751,12 @@ bool cvc_send_opmsg_obpm_get_status(OPERATOR_DATA *op_data, void *message_data,
         resp = cpsPackWords(op_extra_data->mute_control_ptr,stats[13], resp);
         resp = cpsPackWords(stats[14],stats[15] , resp);
         resp = cpsPackWords(stats[16],stats[17] , resp);
+#ifdef INSTALL_FRAME_TRACE
+        /* Frame trace follows the statistics */
+        frame_trace_pack_status(&op_extra_data->frame_trace, stats[18], resp);
+#else
         cpsPackWords(stats[18],NULL , resp);
+#endif
         /* Reset Peak Detectors AEC_REF/MIC3/MIC4 */
         *(stats[14])=0;
         *(stats[15])=0;
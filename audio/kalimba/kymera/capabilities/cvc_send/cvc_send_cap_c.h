@@ -13,6 +13,9 @@
 #include "volume/shared_volume_control.h"
 #include "op_msg_utilities.h"
 #include "ps/ps.h"
+#ifdef INSTALL_FRAME_TRACE
+#include "frame_trace.h"
+#endif
 
 /* Capability   Version */
 #define CVC_SEND_CAP_VERSION_MINOR                          0
@@ -86,6 +89,9 @@ typedef struct
 
     unsigned secure_key[2];
     CPS_PARAM_DEF parms_def;
+#ifdef INSTALL_FRAME_TRACE
+    FRAME_TRACE frame_trace;                    /**< Processing time and arrival of the latest frames */
+#endif
 	
 }CVC_SEND_OP_DATA;
 
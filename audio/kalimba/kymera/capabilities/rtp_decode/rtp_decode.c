@@ -68,6 +68,7 @@ const opmsg_handler_lookup_table_entry rtp_decode_opmsg_handler_table[] =
     {OPMSG_COMMON_SET_SAMPLE_RATE,               rtp_decode_opmsg_set_sample_rate},
     {OPMSG_COMMON_ID_SET_BUFFER_SIZE,            rtp_decode_opmsg_set_buffer_size},
     {OPMSG_RTP_DECODE_ID_SET_PACKING ,           rtp_decode_opmsg_set_packing},
+    {OPMSG_COMMON_ID_GET_STATUS,                 rtp_decode_opmsg_get_status},
     {0, NULL}};
 
 /** Constant capability description of rtp_decode capability */
@@ -155,42 +156,24 @@ static void rtp_set_payload_header_size(RTP_DECODE_OP_DATA *opx_data)
 }
 
 /**
- * Reads the RTP header and calculates the samples encoded in the packet.
+ * Reads the RTP timestamp and source out of the fixed RTP header.
  * Number of sample = current RTP header timestamp - previous RTP header timestamp
  *
- * \param opx_data Pointer to the RTP operator data.
- * \param header_size RTP header size.
+ * \param fixed_header The fixed RTP header, one octet per word.
+ * \param header Where to write the timestamp and source.
  */
-static void rtp_header_decode(RTP_DECODE_OP_DATA *opx_data, unsigned header_size, RTP_HEADER_DATA *header)
+static void rtp_header_decode(const unsigned int *fixed_header, RTP_HEADER_DATA *header)
 {
-
-    tCbuffer *ip_buffer = opx_data->ip_buffer;
-    unsigned int fixed_header[RTP_FIXED_HEADER_TIMESTAMP_PART_LENGTH + RTP_FIXED_HEADER_SOURCE_PART_LENGTH];
-    TIME rtp_timestamp;
-    uint32 rtp_source;
-
-    /* Get the sequence number */
-    unpack_cbuff_to_array((int*)fixed_header, ip_buffer, 
-        RTP_FIXED_HEADER_TIMESTAMP_PART_LENGTH + RTP_FIXED_HEADER_SOURCE_PART_LENGTH);
+    const unsigned int *ts = &fixed_header[RTP_FIXED_HEADER_FIRST_PART_LENGTH];
+    const unsigned int *src = &ts[RTP_FIXED_HEADER_TIMESTAMP_PART_LENGTH];
 
     /* The RTP timestamp field is actually a sample count.
      * This sample count should be used to generate the time to play
      * timestamp . */
-    rtp_timestamp = (((uint32)fixed_header[0])<<24) + (fixed_header[1]<<16) + (fixed_header[2]<<8) + fixed_header[3];
-    rtp_source = (((uint32)fixed_header[4])<<24) + (fixed_header[5]<<16) + (fixed_header[6]<<8) + fixed_header[7];
-
-    /* Protected from the rtp timestamp overflow.*/
+    header->timestamp = (((uint32)ts[0])<<24) + (ts[1]<<16) + (ts[2]<<8) + ts[3];
+    header->source = (((uint32)src[0])<<24) + (src[1]<<16) + (src[2]<<8) + src[3];
 
-    /* TODO make this a L4 log*/
-    L4_DBG_MSG2("RTP decode: rtp_timestamp = %u source = %u", rtp_timestamp, rtp_source);
-
-    /* Save the RTP timestamp */
-
-    /* Discard the rest of the header. */
-    cbuffer_advance_read_ptr_ex(ip_buffer, header_size -
-            (RTP_FIXED_HEADER_FIRST_PART_LENGTH + RTP_FIXED_HEADER_TIMESTAMP_PART_LENGTH + RTP_FIXED_HEADER_SOURCE_PART_LENGTH));
-    header->timestamp = rtp_timestamp;
-    header->source = rtp_source;
+    L4_DBG_MSG2("RTP decode: rtp_timestamp = %u source = %u", header->timestamp, header->source);
 }
 
 
@@ -1172,6 +1155,8 @@ static void metadata_transport_with_ttp(RTP_DECODE_OP_DATA *opx_data, unsigned o
 /**
  * Function which tries to empty the internal buffers of the RTP decode
  * by copying to output.
+ * While the packed internal buffer is empty, frames go from the frame buffer
+ * straight to the output and only what does not fit is packed.
  */
 static void rtp_decode_empty_internal_buffers(RTP_DECODE_OP_DATA *opx_data,TOUCHED_TERMINALS *touched)
 {
@@ -1181,6 +1166,17 @@ static void rtp_decode_empty_internal_buffers(RTP_DECODE_OP_DATA *opx_data,TOUCH
         return;
     }
     data = buff_metadata_available_octets(opx_data->u.pack.frame_buffer);
+    if ((data > 0) && (buff_metadata_available_octets(opx_data->u.pack.internal_buffer) == 0))
+    {
+        unsigned direct = cbuffer_copy_ex(opx_data->op_buffer, opx_data->u.pack.frame_buffer,
+                                          MIN(data, cbuffer_calc_amount_space_ex(opx_data->op_buffer)));
+        if (direct > 0)
+        {
+            metadata_strict_transport(opx_data->u.pack.frame_buffer, opx_data->op_buffer, direct);
+            touched->sources = TOUCHED_SOURCE_0;
+            data -= direct;
+        }
+    }
     if (data > 0)
     {
         data = cbuffer_copy_ex(opx_data->u.pack.internal_buffer, opx_data->u.pack.frame_buffer, data);
@@ -1340,15 +1336,16 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
         }
         else
         {
-            unsigned int fixed_header_first_part[RTP_FIXED_HEADER_FIRST_PART_LENGTH];
-            /* read in first few bytes of RTP header */
-            unpack_cbuff_to_array((int*)fixed_header_first_part, ip_buffer, RTP_FIXED_HEADER_FIRST_PART_LENGTH);
+            unsigned int fixed_header[RTP_MINIMUM_HEADER_SIZE];
+            /* Read the fixed RTP header where it is, the read pointer only
+             * moves once the whole header is parsed. */
+            unpack_cbuff_to_array_from_offset((int*)fixed_header, ip_buffer, 0, RTP_MINIMUM_HEADER_SIZE);
 
             /* validate version */
-            if ((fixed_header_first_part[0] & RTP0_VERSION_MASK) != RTP0_VERSION_2)
+            if ((fixed_header[0] & RTP0_VERSION_MASK) != RTP0_VERSION_2)
             {
                 /* Unsupported version - discard */
-                cbuffer_advance_read_ptr_ex(ip_buffer, packet_size - RTP_FIXED_HEADER_FIRST_PART_LENGTH);
+                cbuffer_advance_read_ptr_ex(ip_buffer, packet_size);
                 delete_consumed_metadata_tag(ip_buffer, packet_size);
 #ifdef DEBUG_RTP_DECODE
                 /* Increment decode lost */
@@ -1357,8 +1354,8 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
             }
             else
             {
-                unsigned csrc_count = (fixed_header_first_part[0] & RTP0_CSRC_COUNT_MASK);
-                unsigned seq = fixed_header_first_part[3] | (fixed_header_first_part[2]<<8);
+                unsigned csrc_count = (fixed_header[0] & RTP0_CSRC_COUNT_MASK);
+                unsigned seq = fixed_header[3] | (fixed_header[2]<<8);
                 unsigned padding_amount = 0;
                 unsigned header_size;
                 unsigned payload_size;
@@ -1384,13 +1381,11 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
                 header_size = rtp_header_size + (csrc_count * 4) +
                              opx_data->payload_header_size;
 
-                if ((fixed_header_first_part[0] & RTP0_PADDING) != 0)
+                if ((fixed_header[0] & RTP0_PADDING) != 0)
                 {
-                    /* padding amount is the last byte in the buffer. The first part
-                     * of the header is already read. The current read offset is
-                     * RTP_FIXED_HEADER_FIRST_PART_LENGTH. */
+                    /* padding amount is the last byte in the packet. */
                     unpack_cbuff_to_array_from_offset((int*) &padding_amount, ip_buffer,
-                            packet_size - RTP_FIXED_HEADER_FIRST_PART_LENGTH - 1, 1);
+                            packet_size - 1, 1);
 
                     /* ignore rogue values  */
                     if (padding_amount > (packet_size - header_size))
@@ -1406,7 +1401,7 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
                  * only reliable for APTX adaptive. For other decoders the header is discarded. */
                 if (opx_data->mode == RTP_DECODE && opx_data->codec_type == APTXADAPTIVE)
                 {
-                    rtp_header_decode(opx_data, header_size, &rtp_header);
+                    rtp_header_decode(fixed_header, &rtp_header);
                     if (rtp_header.source != opx_data->prev_src_id)
                     {
                         rtp_source_changed(op_data, rtp_header.source);
@@ -1416,15 +1411,14 @@ void rtp_decode_process_data(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
 #ifdef TTP_SOURCE_TIME_TEST
                 else if (opx_data->mode == RTP_DECODE)
                 {
-                    rtp_header_decode(opx_data, header_size, &rtp_header);
+                    rtp_header_decode(fixed_header, &rtp_header);
                     frame_data.rtp_timestamp = (TIME)((1000000ul*(uint64)rtp_header.timestamp + 
                         (opx_data->sample_rate/2)) / opx_data->sample_rate);
                 }
 #endif
-                else
-                {
-                    cbuffer_advance_read_ptr_ex(ip_buffer, header_size - RTP_FIXED_HEADER_FIRST_PART_LENGTH);
-                }
+
+                /* Skip the header, the payload follows it. */
+                cbuffer_advance_read_ptr_ex(ip_buffer, header_size);
 
                 /* Copy the payload without the padding to the clone buffer. There the
                  * decoded frame is analysed to see how many sample is in it.  */
@@ -1669,6 +1663,52 @@ bool rtp_decode_opmsg_set_ttp_params(OPERATOR_DATA *op_data, void *message_data,
     return TRUE;
 }
 
+bool rtp_decode_opmsg_get_status(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data)
+{
+    RTP_DECODE_OP_DATA *opx_data = get_instance_data(op_data);
+    unsigned *resp = NULL;
+
+    /* Only the modes generating time to play have an estimator */
+    if (opx_data->ttp_instance == NULL)
+    {
+        return FALSE;
+    }
+
+    if (!common_obpm_status_helper(message_data, resp_length, resp_data, sizeof(RTP_DECODE_STATISTICS), &resp))
+    {
+        return FALSE;
+    }
+
+    if (resp)
+    {
+        ttp_estimator_state state;
+        unsigned pword1, pword2;
+
+        ttp_get_estimator_state(opx_data->ttp_instance, &state);
+
+        pword1 = (unsigned)state.type;
+        pword2 = ((unsigned)state.offset >> 16) & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = (unsigned)state.offset & 0xFFFF;
+        pword2 = ((unsigned)state.drift >> 16) & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = (unsigned)state.drift & 0xFFFF;
+        pword2 = ((unsigned)state.innovation >> 16) & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = (unsigned)state.innovation & 0xFFFF;
+        pword2 = (state.updates >> 16) & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = state.updates & 0xFFFF;
+        resp = cpsPackWords(&pword1, NULL, resp);
+    }
+
+    return TRUE;
+}
+
 
 bool rtp_decode_opmsg_set_sample_rate(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data)
 {
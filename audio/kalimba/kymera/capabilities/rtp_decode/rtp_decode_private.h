@@ -225,6 +225,24 @@ static const uint8 mp3_bitrate[2][16] = {
 
 
 
+/**
+ * Status reported for OPMSG_COMMON_ID_GET_STATUS: the state of the TTP
+ * sample period adjustment estimator (see ttp_get_estimator_state).
+ * The 32 bit values are split into 16 bit halves.
+ */
+typedef struct
+{
+    unsigned estimator;
+    unsigned offset_ms;
+    unsigned offset_ls;
+    unsigned drift_ms;
+    unsigned drift_ls;
+    unsigned innovation_ms;
+    unsigned innovation_ls;
+    unsigned updates_ms;
+    unsigned updates_ls;
+}RTP_DECODE_STATISTICS;
+
 /*****************************************************************************
  * Private Function Definitions
  */
@@ -264,6 +282,7 @@ extern bool rtp_decode_opmsg_set_ttp_params(OPERATOR_DATA *op_data, void *messag
 extern bool rtp_decode_opmsg_set_sample_rate(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
 extern bool rtp_decode_opmsg_set_buffer_size(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
 extern bool rtp_decode_opmsg_set_latency_change_notification(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
+extern bool rtp_decode_opmsg_get_status(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
 
 /* Functions for unpacking a 16-bit unpacked buffer to an array, octet by octet. */
 extern void unpack_cbuff_to_array_16bit(int *dest, tCbuffer *cbuffer_src, unsigned int amount_to_copy);
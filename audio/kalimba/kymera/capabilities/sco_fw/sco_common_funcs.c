@@ -243,9 +243,28 @@ void sco_common_rcv_destroy_plc_data(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data)
         pdelete(sco_rcv_op_data->sco_rcv_parameters.plc100_struc);
         sco_rcv_op_data->sco_rcv_parameters.plc100_struc = NULL;
     }
+
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+    frame_plc_destroy(sco_rcv_op_data->sco_rcv_parameters.frame_plc);
+    sco_rcv_op_data->sco_rcv_parameters.frame_plc = NULL;
+    pfree(sco_rcv_op_data->sco_rcv_parameters.frame_plc_buf);
+    sco_rcv_op_data->sco_rcv_parameters.frame_plc_buf = NULL;
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
 }
 #endif /* INSTALL_PLC100 */
 
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+/* create the frame based PLC, freed along with the plc100 data */
+bool sco_common_rcv_create_frame_plc(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data, unsigned sample_rate)
+{
+    sco_rcv_op_data->sco_rcv_parameters.frame_plc = frame_plc_create(FRAME_PLC_MAX_FRAME, sample_rate);
+    sco_rcv_op_data->sco_rcv_parameters.frame_plc_buf = xpnewn(FRAME_PLC_MAX_FRAME, int32);
+
+    return (sco_rcv_op_data->sco_rcv_parameters.frame_plc != NULL) &&
+           (sco_rcv_op_data->sco_rcv_parameters.frame_plc_buf != NULL);
+}
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
+
 
 /* Initialise various working data params of the NB or WB SCO receive operators. */
 bool sco_common_rcv_reset_working_data(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data)
@@ -265,6 +284,13 @@ bool sco_common_rcv_reset_working_data(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data)
 
         plc100_initialize(sco_rcv_op_data->sco_rcv_parameters.plc100_struc);
 #endif /* INSTALL_PLC100 */
+
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+        if (sco_rcv_op_data->sco_rcv_parameters.frame_plc != NULL)
+        {
+            frame_plc_reset(sco_rcv_op_data->sco_rcv_parameters.frame_plc);
+        }
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
     }
 
     return TRUE;
@@ -39,6 +39,19 @@ extern void sco_common_rcv_initialise(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data);
 void sco_common_rcv_destroy_plc_data(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data);
 #endif /* INSTALL_PLC100 */
 
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+/**
+ * \brief Create the frame based PLC used in place of plc100. It is freed by
+ *        sco_common_rcv_destroy_plc_data().
+ *
+ * \param  sco_rcv_op_data  Pointer to the common SCO receive operator data structure.
+ * \param  sample_rate  Sample rate of the decoded speech, 8000 or 16000.
+ *
+ * \return TRUE if completed successfully, FALSE on fail.
+ */
+extern bool sco_common_rcv_create_frame_plc(SCO_COMMON_RCV_OP_DATA* sco_rcv_op_data, unsigned sample_rate);
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
+
 /**
  * \brief Initialise various working data params of the NB or WB SCO receive operators.
  *
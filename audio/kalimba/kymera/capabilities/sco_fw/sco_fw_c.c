@@ -93,23 +93,15 @@ static inline void transform_metadata_header(int *data, CONNECTION_TYPE type, st
     sco_metadata->time_stamp = transform_metadata(data[3], type);
 }
 
-/****************************************************************************
-Public Function Definitions
-*/
-
 /**
- *  Checks if there is enough data in the input buffer.
+ * \brief Returns the amount of data in the input buffer, in words, that
+ *        can be consumed.
  *
  * \param sco_data - Pointer to the common SCO rcv operator data
- * \param data_size - Size of the data which needs reading from the input.
- * \returns If there is enough data, FALSE otherwise
  */
-bool enough_data_to_run(SCO_COMMON_RCV_OP_DATA* sco_data, unsigned data_size)
+static unsigned sco_rcv_input_data(SCO_COMMON_RCV_OP_DATA* sco_data)
 {
-    unsigned input_data;
-
-    /* calc input data */
-    input_data = cbuffer_calc_amount_data_in_words(sco_data->buffers.ip_buffer);
+    unsigned input_data = cbuffer_calc_amount_data_in_words(sco_data->buffers.ip_buffer);
 
 #ifdef SCO_RX_OP_GENERATE_METADATA
     if(buff_has_metadata(sco_data->buffers.ip_buffer))
@@ -124,6 +116,27 @@ bool enough_data_to_run(SCO_COMMON_RCV_OP_DATA* sco_data, unsigned data_size)
     }
 #endif
 
+    return input_data;
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/**
+ *  Checks if there is enough data in the input buffer.
+ *
+ * \param sco_data - Pointer to the common SCO rcv operator data
+ * \param data_size - Size of the data which needs reading from the input.
+ * \returns If there is enough data, FALSE otherwise
+ */
+bool enough_data_to_run(SCO_COMMON_RCV_OP_DATA* sco_data, unsigned data_size)
+{
+    unsigned input_data;
+
+    /* calc input data */
+    input_data = sco_rcv_input_data(sco_data);
+
     SCO_DBG_MSG1("enough_data_to_run: input buffer data |%4d|", input_data);
 
     /* Check for run condition.
@@ -172,50 +185,61 @@ bool enough_space_to_run(SCO_COMMON_RCV_OP_DATA* sco_data, unsigned output_packe
  *  Reads the metadata of the incoming packet and populates it to the stream sco packet
  *  structure.
  *
- * \param ip_buffer - Pointer to the input buffer of the SCO rcv operator.
- * \param in_packet - Pointer to the packet structure to read.
+ *  The header is read with one cbuffer_read. This reads the metadata of one packet
+ *  per call; packets are not batched.
+ *
+ * \param sco_data - Pointer to the common SCO rcv operator data.
+ * \param sco_metadata - Pointer to the packet structure to read.
  * \param type - Type of the packet. 0 SCO, 1 WBS.
  * \returns the status of the read.
  */
 stream_sco_metadata_status read_packet_metadata(SCO_COMMON_RCV_OP_DATA* sco_data, stream_sco_metadata *sco_metadata, CONNECTION_TYPE type)
 {
-    int data[METADATA_HEADER_SIZE - 1];
+    int data[METADATA_HEADER_SIZE];
     tCbuffer *ip_buffer = sco_data->buffers.ip_buffer;
-    unsigned ip_buffer_data = cbuffer_calc_amount_data_in_words(ip_buffer);
+    unsigned ip_buffer_data = sco_rcv_input_data(sco_data);
 
     patch_fn(read_packet_metadata);
 
-#ifdef SCO_RX_OP_GENERATE_METADATA
-    if(buff_has_metadata(ip_buffer))
-    {
-        /* make sure we don't consume more than what metadata indicates */
-        unsigned input_meta = buff_metadata_available_octets(ip_buffer) / OCTETS_PER_SAMPLE;
-        if(input_meta < ip_buffer_data)
-        {
-            SCO_DBG_MSG2("SCO_RCV_DBG, Less metadata than data: data=%d, meta=%d, capped", ip_buffer_data, input_meta);
-            ip_buffer_data = input_meta;
-        }
-    }
-#endif
-
     /* Search for the sync word until it is possible to read a sco metadata header.*/
     while(ip_buffer_data >= METADATA_HEADER_SIZE)
     {
-        /* There is data on the ip buffer so the read must always pass. */
+        int *read_address = ip_buffer->read_ptr;
+        unsigned skip;
+
+        /* Read a whole header in one go. While in sync, which is nearly
+         * always, the sync word is the first word read and this is the only
+         * read of the header. There is data on the ip buffer so the read must
+         * always pass. */
+        cbuffer_read(ip_buffer, data, METADATA_HEADER_SIZE);
+
+        if (transform_metadata(data[0], type) != SYNC_WORD)
+        {
+            /* Out of sync. Skip to the next sync word in what was read, or
+             * past all of it, and search again from there. */
+            for (skip = 1; skip < METADATA_HEADER_SIZE; skip++)
+            {
+                if (transform_metadata(data[skip], type) == SYNC_WORD)
+                {
+                    break;
+                }
+            }
+            cbuffer_set_read_address(ip_buffer, (unsigned int*)read_address);
+            cbuffer_advance_read_ptr(ip_buffer, skip);
 #ifdef SCO_RX_OP_GENERATE_METADATA
-        /* keep metadata aligned with the buffer */
-        sco_rcv_transport_metadata(sco_data, 1, 0, type);
+            /* keep metadata aligned with the buffer */
+            sco_rcv_transport_metadata(sco_data, skip, 0, type);
 #endif
-        cbuffer_read(ip_buffer, data, 1);
-        /* Decrement the available data in the input buffer. */
-        ip_buffer_data--;
-
-        if (transform_metadata(data[0], type) == SYNC_WORD)
+            /* Decrement the available data in the input buffer. */
+            ip_buffer_data -= skip;
+        }
+        else
         {
-
-            /* Syncword found, read the rest of the metadata.
-             * There are enough data because we check at the while statement. */
+            /* Syncword found, and the rest of the metadata read with it. */
 #ifdef SCO_RX_OP_GENERATE_METADATA
+            /* keep metadata aligned with the buffer */
+            sco_rcv_transport_metadata(sco_data, 1, 0, type);
+
             /* at this time the last read tag must be valid, otherwise
              * it's most probably an input buffer wrap around has
              * happened
@@ -229,12 +253,11 @@ stream_sco_metadata_status read_packet_metadata(SCO_COMMON_RCV_OP_DATA* sco_data
             /* keep metadata aligned with the buffer */
             sco_rcv_transport_metadata(sco_data, METADATA_HEADER_SIZE - 1, 0, type);
 #endif /* SCO_RX_OP_GENERATE_METADATA */
-            cbuffer_read(ip_buffer, data, METADATA_HEADER_SIZE - 1);
             /* Decrement the available data in the input buffer. */
-            ip_buffer_data = ip_buffer_data - (METADATA_HEADER_SIZE - 1);
+            ip_buffer_data = ip_buffer_data - METADATA_HEADER_SIZE;
 
             /* Transform the rest of the metadata and check if it is valid. */
-            transform_metadata_header(data, type, sco_metadata);
+            transform_metadata_header(&data[1], type, sco_metadata);
 
             /* check if the SCO metadata length is valid.*/
             if ( sco_metadata->metadata_length != METADATA_HEADER_SIZE )
@@ -666,6 +689,74 @@ void sco_rcv_transport_metadata(SCO_COMMON_RCV_OP_DATA* sco_data,
 }
 #endif
 
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+/**
+ * \brief Writes a packet to the output through the frame based PLC.
+ *
+ * Received speech is read from src and passed through, concealing speech is
+ * made up for a bad or missing packet. The PLC estimates the packet error
+ * rate from the packets it sees, and from it chooses LPC concealment while
+ * the link is good and cheaper pitch repetition when losses are common.
+ * Only as much as fits in the output is written.
+ *
+ * \param sco_data - Pointer to the common SCO rcv operator data
+ * \param src - Buffer holding the packet payload, NULL for a missing packet
+ * \param words - Payload length, in words
+ * \param bad - Whether the payload is to be concealed
+ * \return The number of words written (and read from src)
+ */
+unsigned sco_fw_frame_plc_process(SCO_COMMON_RCV_OP_DATA* sco_data, tCbuffer *src, unsigned words, bool bad)
+{
+    frame_plc *plc = sco_data->sco_rcv_parameters.frame_plc;
+    int32 *frame = sco_data->sco_rcv_parameters.frame_plc_buf;
+    unsigned space, done;
+
+    space = cbuffer_calc_amount_space_in_words(sco_data->buffers.op_buffer);
+    if (words > space)
+    {
+        words = space;
+    }
+
+    /* Frames of a long packet are concealed one after the other */
+    for (done = 0; done < words; done += FRAME_PLC_MAX_FRAME)
+    {
+        unsigned len = words - done;
+
+        if (len > FRAME_PLC_MAX_FRAME)
+        {
+            len = FRAME_PLC_MAX_FRAME;
+        }
+
+        if (src != NULL)
+        {
+            cbuffer_read(src, (int*)frame, len);
+        }
+
+        if (!sco_data->sco_rcv_parameters.force_plc_off)
+        {
+            if (bad || (src == NULL))
+            {
+                frame_plc_conceal(plc, frame, len);
+            }
+            else
+            {
+                frame_plc_good_frame(plc, frame, len);
+            }
+        }
+        else if (src == NULL)
+        {
+            /* With PLC forced off a missing packet is silence */
+            cbuffer_block_fill(sco_data->buffers.op_buffer, len, 0);
+            continue;
+        }
+
+        cbuffer_write(sco_data->buffers.op_buffer, (int*)frame, len);
+    }
+
+    return words;
+}
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
+
 /**
  * \brief Fakes a packet with PLC100.
  *
@@ -707,6 +798,13 @@ unsigned fake_packet(SCO_COMMON_RCV_OP_DATA* sco_data, unsigned packet_size, CON
     /*
     * Do packet loss concealment (PLC).
     */
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+    if (type == SCO_NB)
+    {
+        sco_fw_frame_plc_process(sco_data, NULL, packet_size, TRUE);
+        return TOUCHED_SOURCE_0;
+    }
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
     plc100_process(sco_data->sco_rcv_parameters.plc100_struc);
 
     return TOUCHED_SOURCE_0;
@@ -143,6 +143,9 @@ extern stream_sco_metadata_status analyse_sco_metadata(SCO_COMMON_RCV_OP_DATA* s
 /* Common packet handling functions. */
 extern unsigned fake_packet(SCO_COMMON_RCV_OP_DATA* sco_data, unsigned packet_size, CONNECTION_TYPE type);
 extern void discard_packet(SCO_COMMON_RCV_OP_DATA* sco_data, stream_sco_metadata* discard_packet);
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+extern unsigned sco_fw_frame_plc_process(SCO_COMMON_RCV_OP_DATA* sco_data, tCbuffer *src, unsigned words, bool bad);
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
 
 /* Sco state controlling functions. */
 extern void sco_fw_update_expected_timestamp(SCO_COMMON_RCV_OP_DATA* sco_data);
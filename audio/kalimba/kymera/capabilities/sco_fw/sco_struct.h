@@ -19,6 +19,9 @@
 #ifdef INSTALL_PLC100
 #include "plc100_c.h"
 #endif
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+#include "frame_plc_c.h"
+#endif
 #ifdef CVSD_CODEC_SOFTWARE
 #include "cvsd.h"
 #endif
@@ -112,6 +115,14 @@ typedef struct SCO_RCV_PARAMS
     unsigned md_pkt_faked;
 #endif /* INSTALL_PLC100 */
 
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+    /** Frame based PLC, used by SCO NB receive in place of plc100 */
+    frame_plc *frame_plc;
+
+    /** One frame of samples on their way through frame_plc */
+    int32 *frame_plc_buf;
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
+
 #ifdef CVSD_CODEC_SOFTWARE
 	sCvsdState_t cvsd_struct;
 	int* ptScratch;				// pointer to scratch memory
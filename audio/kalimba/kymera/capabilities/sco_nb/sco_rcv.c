@@ -180,6 +180,17 @@ bool sco_rcv_create(OPERATOR_DATA *op_data, void *message_data, unsigned *respon
         base_op_change_response_status(response_data, STATUS_CMD_FAILED);
         return TRUE;
     }
+
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+    if (!sco_common_rcv_create_frame_plc(sco_rcv, 8000))
+    {
+        /* Free PLC structure and associated allocs */
+        sco_common_rcv_destroy_plc_data(sco_rcv);
+        /* Change the already allocated response to command failed. No extra error info. */
+        base_op_change_response_status(response_data, STATUS_CMD_FAILED);
+        return TRUE;
+    }
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
 #endif /* INSTALL_PLC100 */
 
     /* Initialise some of the operator data that is common between NB and WB receive. It can only be called
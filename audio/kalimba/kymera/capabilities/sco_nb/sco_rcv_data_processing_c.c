@@ -18,6 +18,10 @@ Include Files
 #include "cvsd.h"
 #endif
 
+#if defined(INSTALL_SCO_RX_FRAME_PLC) && (defined(CVSD_CODEC_SOFTWARE) || !defined(INSTALL_PLC100))
+#error "INSTALL_SCO_RX_FRAME_PLC needs INSTALL_PLC100 and works on PCM packets only"
+#endif
+
 /****************************************************************************
 Private Constant Definitions
 */
@@ -260,7 +264,8 @@ unsigned sco_rcv_processing(OPERATOR_DATA *op_data)
 Private Function Definitions
 */
 /**
- * \brief Copies a valid packet to the output buffer. Runs plc100 on the output.
+ * \brief Copies a valid packet to the output buffer. Runs plc100, or the frame
+ *        based PLC if INSTALL_SCO_RX_FRAME_PLC is defined, on the output.
  *
  * \param sco_data - Pointer to the common SCO rcv operator data
  * \param current_packet - current packet containing the metadata information.
@@ -268,11 +273,11 @@ Private Function Definitions
 static unsigned copy_packet(SCO_COMMON_RCV_OP_DATA* sco_data, stream_sco_metadata* sco_metadata)
 {
     unsigned amount_copied, output_words;
-#ifdef INSTALL_PLC100
+#if defined(INSTALL_PLC100) && !defined(INSTALL_SCO_RX_FRAME_PLC)
     int *op_buffer_write_address;
     unsigned out_space;
     bool space_limited = FALSE;
-#endif /* INSTALL_PLC100 */
+#endif /* INSTALL_PLC100 && !INSTALL_SCO_RX_FRAME_PLC */
 
     /* What the metadata record says the payload length is (words).
      * (After read_packet_metadata() has sanitised it for buffer
@@ -287,6 +292,18 @@ static unsigned copy_packet(SCO_COMMON_RCV_OP_DATA* sco_data, stream_sco_metadat
     sco_data->sco_rcv_parameters.num_good_pkts_per_kick++;
     sco_data->sco_rcv_parameters.frame_count++;
 
+#ifdef INSTALL_SCO_RX_FRAME_PLC
+    /* The frame based PLC moves the packet to the output itself, concealing
+     * it if it arrived bad. */
+    amount_copied = sco_fw_frame_plc_process(sco_data, sco_data->buffers.ip_buffer, output_words,
+                                             (sco_metadata->status != OK));
+#ifdef SCO_RX_OP_GENERATE_METADATA
+    sco_rcv_transport_metadata(sco_data,
+                               amount_copied, /* input_processed */
+                               amount_copied, /* output_generated */
+                               SCO_NB);
+#endif
+#else /* INSTALL_SCO_RX_FRAME_PLC */
 
 #ifdef INSTALL_PLC100
     if (sco_data->sco_rcv_parameters.force_plc_off)
@@ -361,6 +378,7 @@ static unsigned copy_packet(SCO_COMMON_RCV_OP_DATA* sco_data, stream_sco_metadat
     }
 
 #endif /* INSTALL_PLC100 */
+#endif /* INSTALL_SCO_RX_FRAME_PLC */
 
     SCO_DBG_MSG2("After copy!  input buffer data |%4d|, output buffer space |%4d|.",
                                 cbuffer_calc_amount_data_in_words(sco_data->buffers.ip_buffer),
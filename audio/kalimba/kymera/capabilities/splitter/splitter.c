@@ -52,6 +52,7 @@ const opmsg_handler_lookup_table_entry splitter_opmsg_handler_table[] =
     {OPMSG_SPLITTER_ID_SET_PACKING,                       splitter_set_packing},
     {OPMSG_SPLITTER_ID_SET_REFRAMING,                     splitter_set_reframing},
     {OPMSG_COMMON_SET_SAMPLE_RATE,                        splitter_set_sample_rate},
+    {OPMSG_COMMON_ID_GET_STATUS,                          splitter_get_status},
     {0, NULL}
 };
 
@@ -152,7 +153,8 @@ static void splitter_timer_task(void *timer_data)
 static void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_TERMINALS *touched)
 {
     SPLITTER_OP_DATA *splitter = get_instance_data(op_data);
-    unsigned i, min_new_data, min_new_space;
+    unsigned i, min_new_data, min_new_space, max_new_space;
+    unsigned stalled_streams, active_outputs;
     int *new_output_write_addr;
     int *new_input_read_addr;
 
@@ -166,6 +168,9 @@ static void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_TERMINAL
      * a result. Cbuffer API is subverted because it isn't designed for this.
      */
     min_new_data = min_new_space = UINT_MAX;
+    max_new_space = 0;
+    stalled_streams = 0;
+    active_outputs = 0;
     /* Iterate through the list of all active channels. */
     while (NULL != channel)
     {
@@ -178,6 +183,7 @@ static void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_TERMINAL
             if (channel->output_state[i])
             {
                 out = channel->output_buffer[i];
+                active_outputs++;
 
                 /* Find out minimum available space. */
                 new_space = (char *)out->read_ptr - (char *)in->read_ptr;
@@ -190,6 +196,14 @@ static void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_TERMINAL
                 {
                     min_new_space = new_space;
                 }
+                if (new_space > max_new_space)
+                {
+                    max_new_space = new_space;
+                }
+                if (new_space == 0)
+                {
+                    stalled_streams |= 1 << i;
+                }
             }
         }
 
@@ -208,6 +222,14 @@ static void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_TERMINAL
         channel = channel->next;
     }
 
+    /* An output that has read nothing holds back the input, and so every
+     * other output, once that has read everything. */
+    if ((min_new_space == 0) && (max_new_space > 0))
+    {
+        splitter->slow_output_kicks++;
+        splitter->slow_streams = stalled_streams;
+    }
+
     /* Typically only one of  min_new_space OR min_new_data are non zero on a
      * given kick so we separate the looping out to reduce the amount of work done.
      */
@@ -298,6 +320,8 @@ static void splitter_process_data_clone(OPERATOR_DATA *op_data, TOUCHED_TERMINAL
             }
             channel = channel->next;
         }
+        /* Every active output sees the new data without it being copied. */
+        splitter->octets_cloned += min_new_data * active_outputs;
         touched->sources = splitter->touched_sources;
     }
 
@@ -718,6 +742,8 @@ static unsigned pack_to_internal(SPLITTER_OP_DATA *splitter, const cbuffer_funct
             data_to_pack = packed;
         }
 
+        splitter->octets_copied += packed * cbuffer->data_size;
+
         channel = channel->next;
     }
     /* Transport metadata to the internal buffer. */
@@ -865,6 +891,7 @@ static void unpack_data_from_internal_to_output(SPLITTER_OP_DATA *splitter, cons
 
                 /* Unpack/copy the data to the output. */
                 cbuffer->unpack(out, internal, data[i]);
+                splitter->octets_copied += data[i] * cbuffer->data_size;
 
                 /* cbuffer->unpack updates the read pointer for the internal buffer.
                  * Update the read pointer/index for the output.*/
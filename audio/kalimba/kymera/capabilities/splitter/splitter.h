@@ -47,5 +47,6 @@ extern bool splitter_deactivate_streams(OPERATOR_DATA *op_data, void *message_da
 extern bool splitter_buffer_streams(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
 extern bool splitter_set_reframing(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
 extern bool splitter_set_sample_rate(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
+extern bool splitter_get_status(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data);
 
 #endif /* SPLITTER_H */
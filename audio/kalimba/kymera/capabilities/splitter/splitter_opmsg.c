@@ -1180,3 +1180,53 @@ bool splitter_set_sample_rate(OPERATOR_DATA *op_data, void *message_data, unsign
     splitter->reframe_data.sample_rate = sample_rate;
     return TRUE;
 }
+
+/**
+ * \brief Reports how the data reached the outputs: the octets given to them
+ *     by cloning the input buffer, the octets copied while buffering, and
+ *     how often a slow output held the others back while cloning.
+ *
+ * \param op_data Pointer to the operator instance data
+ * \param message_data Pointer to the get status request message
+ * \param resp_length Location to write the response message length
+ * \param resp_data Location to write a pointer to the response message
+ *
+ * \return Whether the response_data field has been populated with a valid
+ * response
+ */
+bool splitter_get_status(OPERATOR_DATA *op_data, void *message_data, unsigned *resp_length, OP_OPMSG_RSP_PAYLOAD **resp_data)
+{
+    SPLITTER_OP_DATA *splitter = get_instance_data(op_data);
+    unsigned *resp = NULL;
+
+    if (!common_obpm_status_helper(message_data, resp_length, resp_data, sizeof(SPLITTER_STATISTICS), &resp))
+    {
+        return FALSE;
+    }
+
+    if (resp)
+    {
+        unsigned pword1, pword2;
+
+        pword1 = (unsigned)splitter->working_mode;
+        pword2 = (unsigned)(splitter->octets_cloned >> 32) & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = (unsigned)(splitter->octets_cloned >> 16) & 0xFFFF;
+        pword2 = (unsigned)splitter->octets_cloned & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = (unsigned)(splitter->octets_copied >> 32) & 0xFFFF;
+        pword2 = (unsigned)(splitter->octets_copied >> 16) & 0xFFFF;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = (unsigned)splitter->octets_copied & 0xFFFF;
+        pword2 = splitter->slow_output_kicks;
+        resp = cpsPackWords(&pword1, &pword2, resp);
+
+        pword1 = splitter->slow_streams;
+        resp = cpsPackWords(&pword1, NULL, resp);
+    }
+
+    return TRUE;
+}
@@ -278,6 +278,22 @@ typedef struct
     /** True if splitter reframes the incoming timestamps. */
     bool reframe_enabled:1;
 
+    /** Octets the outputs were given by cloning, counted once per output.
+     *  This is data that reached an output without being copied. 64 bit as
+     *  32 bits would wrap within hours of high rate audio. */
+    uint64 octets_cloned;
+
+    /** Octets copied, into the internal buffer and from it to the outputs. */
+    uint64 octets_copied;
+
+    /** Number of kicks on which a slow output held the input back while
+     * cloning, so no output could be given new data. */
+    unsigned slow_output_kicks;
+
+    /** Output streams that were holding the input back on the last such
+     * kick, as an OPMSG_SPLITTER_RUNNING_STREAMS bitfield. */
+    unsigned slow_streams;
+
     /* Debug variables */
     bool internal_buffer_empty:1;
     bool internal_buffer_full:1;
@@ -296,6 +312,23 @@ typedef struct
     unsigned data_size;
 }cbuffer_functions_t;
 
+/**
+ * Status reported for OPMSG_COMMON_ID_GET_STATUS. The low 48 bits of the
+ * octet counts are reported, split into 16 bit words, most significant first.
+ */
+typedef struct
+{
+    unsigned working_mode;
+    unsigned octets_cloned_hi;
+    unsigned octets_cloned_mid;
+    unsigned octets_cloned_lo;
+    unsigned octets_copied_hi;
+    unsigned octets_copied_mid;
+    unsigned octets_copied_lo;
+    unsigned slow_output_kicks;
+    unsigned slow_streams;
+}SPLITTER_STATISTICS;
+
 typedef struct
 {
     unsigned channel_id;
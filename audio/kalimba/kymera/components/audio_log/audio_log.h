@@ -82,7 +82,14 @@
  * Note: This trick requires a toolchain (e.g. binutils) that can be directed
  * to place strings in a special segment.
  *
- * On non-embeded targets the log is output directly to stdout.
+ * On non-embeded targets the log is output directly to stdout, unless
+ * AUDIO_LOG_SOFT_BINARY is defined. In that case the log calls only store
+ * the format string address and raw arguments in a ring buffer, as the
+ * firmware does, so that logging does not perturb timing. The ring is
+ * turned into text by audio_log_soft_flush(), or written out with
+ * audio_log_soft_dump() for tools/audio_log/audio_log_decode.py.
+ * AUDIO_LOG_SOFT_PROFILE accumulates the time spent in log calls in either
+ * mode (see audio_log_soft_get_stats()).
  */
 
 /*****************************************************************************
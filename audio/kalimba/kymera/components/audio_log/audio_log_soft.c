@@ -24,6 +24,9 @@
 #include <stdarg.h>
 #include <string.h>
 #include <errno.h>
+#if defined(AUDIO_LOG_SOFT_BINARY) || defined(AUDIO_LOG_SOFT_PROFILE)
+#include <time.h>
+#endif
 
 #include "hydra_macros.h"
 
@@ -33,11 +36,98 @@
 
 #define AUDIO_LOG_MAX_FILE_LEN 512
 
+#if defined(AUDIO_LOG_SOFT_BINARY)
+/**
+ * Number of records in the binary ring.
+ *
+ * Must be a power of 2
+ */
+#if !defined(AUDIO_LOG_SOFT_RING_SIZE)
+#define AUDIO_LOG_SOFT_RING_SIZE 4096
+#endif
+
+#define AUDIO_LOG_SOFT_RING_MASK (AUDIO_LOG_SOFT_RING_SIZE - 1)
+
+/** Maximum number of arguments in one record (see AUDIO_LOG5). */
+#define AUDIO_LOG_SOFT_MAX_ARGS  5
+
+/** Octets kept per record for copies of "%s" arguments, including their
+ *  terminators. Longer strings are truncated. */
+#if !defined(AUDIO_LOG_SOFT_STR_ARG_LEN)
+#define AUDIO_LOG_SOFT_STR_ARG_LEN 64
+#endif
+
+/** Dump keys of "%s" argument copies have this bit set, so they cannot
+ *  clash with the address of a format or file name string. */
+#define AUDIO_LOG_SOFT_STR_ARG_KEY (1ULL << 63)
+
+/** Size of the table remembering which strings were already dumped.
+ *  Must be a power of 2. */
+#define AUDIO_LOG_SOFT_STR_TABLE_SIZE 1024
+
+/* Dump file layout, see tools/audio_log/audio_log_decode.py */
+#define AUDIO_LOG_SOFT_DUMP_MAGIC   "KALOGBIN"
+#define AUDIO_LOG_SOFT_DUMP_VERSION 2
+#define AUDIO_LOG_SOFT_DUMP_STRING  'S'
+#define AUDIO_LOG_SOFT_DUMP_EVENT   'E'
+#define AUDIO_LOG_SOFT_DUMP_LOST    'L'
+#endif /* AUDIO_LOG_SOFT_BINARY */
+
 #ifdef INSTALL_AUDIO_LOG
 /* We only support Linux builds */
 #define SEPARATOR_DIR_SLASH '/'
 #endif
 
+#if defined(AUDIO_LOG_SOFT_BINARY)
+/**
+ * One binary log record.
+ *
+ * seq is written last by the producer and holds the ticket of the event + 1,
+ * so the reader can tell a complete record from one being written or one
+ * that has already been overwritten by a later event.
+ *
+ * "%s" arguments are copied into str when the event is logged, the caller's
+ * string may be gone by the time the record is read. Their entries in args
+ * hold the offset of the copy in str, and bit n of str_args is set for
+ * args[n].
+ */
+typedef struct
+{
+    volatile unsigned long seq;
+    unsigned long long time_us;
+    const char *fmt;
+    const char *file;
+    int line;
+    unsigned n_args;
+    unsigned str_args;
+    audio_log_elem args[AUDIO_LOG_SOFT_MAX_ARGS];
+    char str[AUDIO_LOG_SOFT_STR_ARG_LEN];
+} audio_log_soft_record;
+#endif /* AUDIO_LOG_SOFT_BINARY */
+
+/*****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if defined(AUDIO_LOG_SOFT_BINARY)
+/** Record ring. Producers claim slots lock-free with an atomic increment. */
+static audio_log_soft_record audio_log_soft_ring[AUDIO_LOG_SOFT_RING_SIZE];
+
+/** Ticket of the next record to be written. */
+static unsigned long audio_log_soft_write_ticket;
+
+/** Ticket of the next record to be read by flush/dump. */
+static unsigned long audio_log_soft_read_ticket;
+
+/** Strings already written to the dump stream. */
+static const char *audio_log_soft_dumped_str[AUDIO_LOG_SOFT_STR_TABLE_SIZE];
+
+/** Stream the dump header has been written to. */
+static FILE *audio_log_soft_dump_file;
+#endif /* AUDIO_LOG_SOFT_BINARY */
+
+static audio_log_soft_stats audio_log_soft_counters;
+
 /*****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -75,6 +165,213 @@ static void printf_time(void)
 #endif
 }
 
+#if defined(AUDIO_LOG_SOFT_BINARY) || defined(AUDIO_LOG_SOFT_PROFILE)
+/**
+ * Monotonic time in nanoseconds.
+ */
+static unsigned long long get_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#endif
+
+#if defined(AUDIO_LOG_SOFT_PROFILE)
+#define PROFILE_START() unsigned long long prof_start = get_time_ns()
+#define PROFILE_STOP() \
+    __atomic_fetch_add(&audio_log_soft_counters.total_ns, \
+                       get_time_ns() - prof_start, __ATOMIC_RELAXED)
+#else
+#define PROFILE_START() ((void)0)
+#define PROFILE_STOP() ((void)0)
+#endif
+
+#if defined(AUDIO_LOG_SOFT_BINARY)
+/**
+ * Copy the oldest complete record out of the ring.
+ *
+ * Records overwritten before they could be read are skipped and counted.
+ *
+ * \return TRUE if a record was copied to rec.
+ */
+static bool ring_read(audio_log_soft_record *rec)
+{
+    for (;;)
+    {
+        unsigned long ticket = audio_log_soft_read_ticket;
+        unsigned long write = __atomic_load_n(&audio_log_soft_write_ticket,
+                                              __ATOMIC_ACQUIRE);
+        audio_log_soft_record *slot;
+        unsigned long seq;
+
+        if (ticket == write)
+        {
+            return FALSE;
+        }
+        if (write - ticket > AUDIO_LOG_SOFT_RING_SIZE)
+        {
+            /* The writers lapped us, skip to the oldest surviving record */
+            audio_log_soft_counters.lost += write - ticket -
+                                            AUDIO_LOG_SOFT_RING_SIZE;
+            audio_log_soft_read_ticket = write - AUDIO_LOG_SOFT_RING_SIZE;
+            continue;
+        }
+
+        slot = &audio_log_soft_ring[ticket & AUDIO_LOG_SOFT_RING_MASK];
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq <= ticket)
+        {
+            /* Claimed but not completely written yet */
+            return FALSE;
+        }
+        *rec = *slot;
+        /* Re-check, the slot may have been reused while we copied it */
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != ticket + 1 ||
+            seq != ticket + 1)
+        {
+            audio_log_soft_counters.lost++;
+            audio_log_soft_read_ticket = ticket + 1;
+            continue;
+        }
+        audio_log_soft_read_ticket = ticket + 1;
+        return TRUE;
+    }
+}
+
+/**
+ * Format a record the same way audio_log_soft() does. Arguments are passed
+ * on as audio_log_elem, which matches int/pointer varargs on our hosts.
+ */
+static void print_record(const audio_log_soft_record *rec)
+{
+    audio_log_elem a[AUDIO_LOG_SOFT_MAX_ARGS] = {0};
+    unsigned i;
+
+    for (i = 0; i < rec->n_args; i++)
+    {
+        a[i] = (rec->str_args & (1u << i)) ? (audio_log_elem)&rec->str[rec->args[i]]
+                                          : rec->args[i];
+    }
+
+    printf_time();
+    printf("%s(%u):", extract_module_name(rec->file), rec->line);
+    printf(rec->fmt, a[0], a[1], a[2], a[3], a[4]);
+    printf("\n");
+}
+
+/**
+ * Write a string record to the dump stream unless it's already there.
+ * Strings are keyed on their address, as the records are.
+ */
+static void dump_string(FILE *out, const char *str)
+{
+    unsigned idx = (unsigned)(((uintptr_t)str >> 2) *
+                              2654435761u) & (AUDIO_LOG_SOFT_STR_TABLE_SIZE - 1);
+    unsigned probe;
+    uint32 len;
+    uint64 key;
+
+    if (str == NULL)
+    {
+        return;
+    }
+    for (probe = 0; probe < AUDIO_LOG_SOFT_STR_TABLE_SIZE; probe++)
+    {
+        const char **entry = &audio_log_soft_dumped_str[idx];
+        if (*entry == str)
+        {
+            return;
+        }
+        if (*entry == NULL)
+        {
+            *entry = str;
+            break;
+        }
+        idx = (idx + 1) & (AUDIO_LOG_SOFT_STR_TABLE_SIZE - 1);
+    }
+    /* If the table is full the string is just written again */
+
+    len = (uint32)strlen(str);
+    key = (uint64)(uintptr_t)str;
+    fputc(AUDIO_LOG_SOFT_DUMP_STRING, out);
+    fwrite(&key, sizeof(key), 1, out);
+    fwrite(&len, sizeof(len), 1, out);
+    fwrite(str, 1, len, out);
+}
+
+/**
+ * Find which of the first n_args arguments of fmt are "%s" conversions.
+ *
+ * \return Bit n set if argument n is a string.
+ */
+static unsigned string_arg_mask(const char *fmt, unsigned n_args)
+{
+    const char *p = fmt;
+    unsigned arg = 0;
+    unsigned mask = 0;
+
+    while (*p != '\0' && arg < n_args)
+    {
+        if (*p++ != '%')
+        {
+            continue;
+        }
+        if (*p == '%')
+        {
+            p++;
+            continue;
+        }
+        /* Skip flags, width, precision and length modifiers */
+        while (*p != '\0' && strchr("-+ #0123456789.hlLzjt", *p) != NULL)
+        {
+            p++;
+        }
+        if (*p == 's')
+        {
+            mask |= 1u << arg;
+        }
+        if (*p != '\0')
+        {
+            p++;
+        }
+        arg++;
+    }
+    return mask;
+}
+
+/**
+ * Write the copies of the "%s" arguments of a record to the dump stream.
+ * Each copy gets its own key, made from the record's sequence number, and
+ * the argument is written as that key.
+ */
+static void dump_string_args(FILE *out, const audio_log_soft_record *rec,
+                             uint64 *keys)
+{
+    unsigned i;
+
+    for (i = 0; i < rec->n_args; i++)
+    {
+        if (rec->str_args & (1u << i))
+        {
+            const char *str = &rec->str[rec->args[i]];
+            uint32 len = (uint32)strlen(str);
+
+            keys[i] = AUDIO_LOG_SOFT_STR_ARG_KEY |
+                      ((uint64)rec->seq * AUDIO_LOG_SOFT_MAX_ARGS + i);
+            fputc(AUDIO_LOG_SOFT_DUMP_STRING, out);
+            fwrite(&keys[i], sizeof(keys[i]), 1, out);
+            fwrite(&len, sizeof(len), 1, out);
+            fwrite(str, 1, len, out);
+        }
+        else
+        {
+            keys[i] = (uint64)rec->args[i];
+        }
+    }
+}
+#endif /* AUDIO_LOG_SOFT_BINARY */
+
 /*****************************************************************************
  * Public Data.
  ****************************************************************************/
@@ -88,7 +385,10 @@ audio_log_level audio_log_current_level = AUDIO_LOG_V_V_VERBOSE;
 void audio_log_soft(const char *name, int line, const char *fmt, ...)
 {
     va_list va_argp;
-    const char *fname = extract_module_name(name);
+    const char *fname;
+    PROFILE_START();
+
+    fname = extract_module_name(name);
 
     /*
      * Prefix time, file & line.
@@ -107,6 +407,158 @@ void audio_log_soft(const char *name, int line, const char *fmt, ...)
     va_end( va_argp );
 
     printf("\n");
+
+    __atomic_fetch_add(&audio_log_soft_counters.calls, 1, __ATOMIC_RELAXED);
+    PROFILE_STOP();
+}
+
+#if defined(AUDIO_LOG_SOFT_BINARY)
+void audio_log_soft_binary(const char *name, int line, const char *fmt,
+                           unsigned n_args, ...)
+{
+    va_list va_argp;
+    unsigned long ticket;
+    audio_log_soft_record *slot;
+    unsigned i;
+    size_t str_used = 0;
+    PROFILE_START();
+
+    /* Claim a slot. If the ring is full the oldest record is overwritten,
+     * just like the firmware circular buffer. */
+    ticket = __atomic_fetch_add(&audio_log_soft_write_ticket, 1,
+                                __ATOMIC_ACQ_REL);
+    slot = &audio_log_soft_ring[ticket & AUDIO_LOG_SOFT_RING_MASK];
+
+    /* Invalidate the slot while it is being rewritten */
+    __atomic_store_n(&slot->seq, 0, __ATOMIC_RELEASE);
+    slot->time_us = get_time_ns() / 1000;
+    slot->fmt = fmt;
+    slot->file = name;
+    slot->line = line;
+    slot->n_args = n_args;
+    slot->str_args = (n_args != 0) ? string_arg_mask(fmt, n_args) : 0;
+
+    va_start(va_argp, n_args);
+    for (i = 0; i < n_args; i++)
+    {
+        slot->args[i] = va_arg(va_argp, audio_log_elem);
+        if (slot->str_args & (1u << i))
+        {
+            /* Keep a copy, the string may not outlive the call */
+            const char *str = (const char *)slot->args[i];
+            size_t len;
+
+            if (str == NULL)
+            {
+                str = "(null)";
+            }
+            len = strlen(str);
+            if (len > AUDIO_LOG_SOFT_STR_ARG_LEN - 1 - str_used)
+            {
+                len = AUDIO_LOG_SOFT_STR_ARG_LEN - 1 - str_used;
+            }
+            memcpy(&slot->str[str_used], str, len);
+            slot->str[str_used + len] = '\0';
+            slot->args[i] = str_used;
+            /* Once full, further strings share the last terminator */
+            str_used += len + 1;
+            if (str_used > AUDIO_LOG_SOFT_STR_ARG_LEN - 1)
+            {
+                str_used = AUDIO_LOG_SOFT_STR_ARG_LEN - 1;
+            }
+        }
+    }
+    va_end(va_argp);
+
+    __atomic_store_n(&slot->seq, ticket + 1, __ATOMIC_RELEASE);
+
+    __atomic_fetch_add(&audio_log_soft_counters.calls, 1, __ATOMIC_RELAXED);
+    PROFILE_STOP();
+}
+
+unsigned audio_log_soft_flush(void)
+{
+    audio_log_soft_record rec;
+    unsigned count = 0;
+
+    while (ring_read(&rec))
+    {
+        print_record(&rec);
+        count++;
+    }
+    return count;
+}
+
+unsigned audio_log_soft_dump(FILE *out)
+{
+    audio_log_soft_record rec;
+    unsigned long lost = audio_log_soft_counters.lost;
+    unsigned count = 0;
+
+    if (out != audio_log_soft_dump_file)
+    {
+        uint16 version = AUDIO_LOG_SOFT_DUMP_VERSION;
+        uint16 elem_size = sizeof(audio_log_elem);
+
+        fwrite(AUDIO_LOG_SOFT_DUMP_MAGIC, 1,
+               sizeof(AUDIO_LOG_SOFT_DUMP_MAGIC) - 1, out);
+        fwrite(&version, sizeof(version), 1, out);
+        fwrite(&elem_size, sizeof(elem_size), 1, out);
+        memset(audio_log_soft_dumped_str, 0, sizeof(audio_log_soft_dumped_str));
+        audio_log_soft_dump_file = out;
+    }
+
+    while (ring_read(&rec))
+    {
+        uint64 key;
+        uint64 args[AUDIO_LOG_SOFT_MAX_ARGS];
+        uint32 word;
+        uint8 n_args = (uint8)rec.n_args;
+
+        if (audio_log_soft_counters.lost != lost)
+        {
+            word = (uint32)(audio_log_soft_counters.lost - lost);
+            lost = audio_log_soft_counters.lost;
+            fputc(AUDIO_LOG_SOFT_DUMP_LOST, out);
+            fwrite(&word, sizeof(word), 1, out);
+        }
+
+        dump_string(out, rec.fmt);
+        dump_string(out, rec.file);
+        dump_string_args(out, &rec, args);
+
+        fputc(AUDIO_LOG_SOFT_DUMP_EVENT, out);
+        key = (uint64)rec.time_us;
+        fwrite(&key, sizeof(key), 1, out);
+        key = (uint64)(uintptr_t)rec.fmt;
+        fwrite(&key, sizeof(key), 1, out);
+        key = (uint64)(uintptr_t)rec.file;
+        fwrite(&key, sizeof(key), 1, out);
+        word = (uint32)rec.line;
+        fwrite(&word, sizeof(word), 1, out);
+        fwrite(&n_args, sizeof(n_args), 1, out);
+        fwrite(args, sizeof(args[0]), rec.n_args, out);
+        count++;
+    }
+    fflush(out);
+    return count;
+}
+#else /* AUDIO_LOG_SOFT_BINARY */
+unsigned audio_log_soft_flush(void)
+{
+    return 0;
+}
+
+unsigned audio_log_soft_dump(FILE *out)
+{
+    NOT_USED(out);
+    return 0;
+}
+#endif /* AUDIO_LOG_SOFT_BINARY */
+
+void audio_log_soft_get_stats(audio_log_soft_stats *stats)
+{
+    *stats = audio_log_soft_counters;
 }
 
 #endif /* defined(INSTALL_AUDIO_SOFT) */
@@ -17,6 +17,40 @@
  * Interface dependencies
  ****************************************************************************/
 
+#include <stdio.h>
+
+/*****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/**
+ * Binary log "element" type.
+ *
+ * As for the firmware variant, every argument is cast to this type so that
+ * the record can be stored without parsing the format string.
+ */
+typedef uintptr_t audio_log_elem;
+
+/*****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/**
+ * Call statistics, see audio_log_soft_get_stats().
+ */
+typedef struct
+{
+    /** Number of events logged. */
+    unsigned long calls;
+
+    /** Events overwritten in the ring before they were flushed. */
+    unsigned long lost;
+
+    /** Total time spent inside the logging call (only with
+     *  AUDIO_LOG_SOFT_PROFILE, zero otherwise). */
+    unsigned long long total_ns;
+} audio_log_soft_stats;
+
 /*****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -39,6 +73,51 @@ extern audio_log_level audio_log_current_level;
  */
 void audio_log_soft(const char *file_name, int line_num, const char *fmt, ...);
 
+/**
+ * Log Event (binary variant).
+ *
+ * Implements the AUDIO_LOG_# macros when AUDIO_LOG_SOFT_BINARY is defined.
+ * Only stores a record in the ring, n_args audio_log_elem follow.
+ *
+ * The format and file name are kept by address, so they must be string
+ * literals. Arguments of "%s" conversions are copied into the record, up to
+ * 63 octets in all per event, as they may not outlive the call.
+ */
+void audio_log_soft_binary(const char *file_name, int line_num,
+                           const char *fmt, unsigned n_args, ...);
+
+/*****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/**
+ * Decode all pending binary records and print them to stdout in the same
+ * format as the text variant. Does nothing in the text variant.
+ *
+ * \return Number of records printed.
+ */
+unsigned audio_log_soft_flush(void);
+
+/**
+ * Write all pending binary records to a file for offline decoding with
+ * tools/audio_log/audio_log_decode.py. Each format and file name is written
+ * to the file once, the first time it is referenced. The copy of each "%s"
+ * argument is written with its event.
+ * Does nothing in the text variant.
+ *
+ * \param out  Stream opened in binary mode.
+ *
+ * \return Number of records written.
+ */
+unsigned audio_log_soft_dump(FILE *out);
+
+/**
+ * Read the call statistics accumulated since start up.
+ *
+ * \param stats  Filled in with the current counters.
+ */
+void audio_log_soft_get_stats(audio_log_soft_stats *stats);
+
 /*****************************************************************************
  * Public Macro specialisations
  ****************************************************************************/
@@ -50,6 +129,54 @@ void audio_log_soft(const char *file_name, int line_num, const char *fmt, ...);
 
 #define AUDIO_LOG_INIT_IMPL() ((void)0)
 
+/*
+ * Emit one event.
+ *
+ * In the default (text) variant the event is formatted straight to stdout.
+ * With AUDIO_LOG_SOFT_BINARY the format string address, source location and
+ * raw arguments are pushed to a ring buffer instead and turned into text
+ * later by audio_log_soft_flush() or, after audio_log_soft_dump(), by
+ * tools/audio_log/audio_log_decode.py.
+ */
+#if defined(AUDIO_LOG_SOFT_BINARY)
+
+#define AUDIO_LOG_SOFT_EMIT0(fmt) \
+    audio_log_soft_binary(__FILE__, __LINE__, (fmt), 0)
+#define AUDIO_LOG_SOFT_EMIT1(fmt, a1) \
+    audio_log_soft_binary(__FILE__, __LINE__, (fmt), 1, \
+        (audio_log_elem)(a1))
+#define AUDIO_LOG_SOFT_EMIT2(fmt, a1, a2) \
+    audio_log_soft_binary(__FILE__, __LINE__, (fmt), 2, \
+        (audio_log_elem)(a1), (audio_log_elem)(a2))
+#define AUDIO_LOG_SOFT_EMIT3(fmt, a1, a2, a3) \
+    audio_log_soft_binary(__FILE__, __LINE__, (fmt), 3, \
+        (audio_log_elem)(a1), (audio_log_elem)(a2), (audio_log_elem)(a3))
+#define AUDIO_LOG_SOFT_EMIT4(fmt, a1, a2, a3, a4) \
+    audio_log_soft_binary(__FILE__, __LINE__, (fmt), 4, \
+        (audio_log_elem)(a1), (audio_log_elem)(a2), (audio_log_elem)(a3), \
+        (audio_log_elem)(a4))
+#define AUDIO_LOG_SOFT_EMIT5(fmt, a1, a2, a3, a4, a5) \
+    audio_log_soft_binary(__FILE__, __LINE__, (fmt), 5, \
+        (audio_log_elem)(a1), (audio_log_elem)(a2), (audio_log_elem)(a3), \
+        (audio_log_elem)(a4), (audio_log_elem)(a5))
+
+#else /* AUDIO_LOG_SOFT_BINARY */
+
+#define AUDIO_LOG_SOFT_EMIT0(fmt) \
+    audio_log_soft(__FILE__, __LINE__, (fmt))
+#define AUDIO_LOG_SOFT_EMIT1(fmt, a1) \
+    audio_log_soft(__FILE__, __LINE__, (fmt), (a1))
+#define AUDIO_LOG_SOFT_EMIT2(fmt, a1, a2) \
+    audio_log_soft(__FILE__, __LINE__, (fmt), (a1), (a2))
+#define AUDIO_LOG_SOFT_EMIT3(fmt, a1, a2, a3) \
+    audio_log_soft(__FILE__, __LINE__, (fmt), (a1), (a2), (a3))
+#define AUDIO_LOG_SOFT_EMIT4(fmt, a1, a2, a3, a4) \
+    audio_log_soft(__FILE__, __LINE__, (fmt), (a1), (a2), (a3), (a4))
+#define AUDIO_LOG_SOFT_EMIT5(fmt, a1, a2, a3, a4, a5) \
+    audio_log_soft(__FILE__, __LINE__, (fmt), (a1), (a2), (a3), (a4), (a5))
+
+#endif /* AUDIO_LOG_SOFT_BINARY */
+
 /*
  * Logging macro implementations.
  *
@@ -61,23 +188,23 @@ void audio_log_soft(const char *file_name, int line_num, const char *fmt, ...);
     do { \
     audio_log_level tmp_lvl = lvl; \
     if (audio_log_current_level >= tmp_lvl) \
-      audio_log_soft(__FILE__,__LINE__, (fmt)); \
+      AUDIO_LOG_SOFT_EMIT0(fmt); \
     } \
     while (0)
 
-#define AUDIO_LOG1(lvl, fmt, a1)\
+#define AUDIO_LOG1(lvl, fmt, a1) \
     do { \
     audio_log_level tmp_lvl = lvl; \
     if (audio_log_current_level >= tmp_lvl) \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1)); \
+      AUDIO_LOG_SOFT_EMIT1(fmt, a1); \
     } \
     while (0)
 
-#define AUDIO_LOG2(lvl, fmt, a1, a2)\
+#define AUDIO_LOG2(lvl, fmt, a1, a2) \
     do { \
     audio_log_level tmp_lvl = lvl; \
     if (audio_log_current_level >= tmp_lvl) \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2)); \
+      AUDIO_LOG_SOFT_EMIT2(fmt, a1, a2); \
     } \
     while (0)
 
@@ -85,7 +212,7 @@ void audio_log_soft(const char *file_name, int line_num, const char *fmt, ...);
     do { \
     audio_log_level tmp_lvl = lvl; \
     if (audio_log_current_level >= tmp_lvl) \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2), (a3)); \
+      AUDIO_LOG_SOFT_EMIT3(fmt, a1, a2, a3); \
     } \
     while (0)
 
@@ -93,7 +220,7 @@ void audio_log_soft(const char *file_name, int line_num, const char *fmt, ...);
     do { \
     audio_log_level tmp_lvl = lvl; \
     if (audio_log_current_level >= tmp_lvl) \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2), (a3), (a4)); \
+      AUDIO_LOG_SOFT_EMIT4(fmt, a1, a2, a3, a4); \
     } \
     while (0)
 
@@ -101,43 +228,43 @@ void audio_log_soft(const char *file_name, int line_num, const char *fmt, ...);
     do { \
     audio_log_level tmp_lvl = lvl; \
     if (audio_log_current_level >= tmp_lvl) \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2), (a3), (a4), (a5)); \
+      AUDIO_LOG_SOFT_EMIT5(fmt, a1, a2, a3, a4, a5); \
     } \
     while (0)
 
 #define AUDIO_ALWAYS_LOG0(fmt) \
     do { \
-      audio_log_soft(__FILE__,__LINE__, (fmt)); \
+      AUDIO_LOG_SOFT_EMIT0(fmt); \
     } \
     while (0)
 
-#define AUDIO_ALWAYS_LOG1(fmt, a1)\
+#define AUDIO_ALWAYS_LOG1(fmt, a1) \
     do { \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1)); \
+      AUDIO_LOG_SOFT_EMIT1(fmt, a1); \
     } \
     while (0)
 
-#define AUDIO_ALWAYS_LOG2(fmt, a1, a2)\
+#define AUDIO_ALWAYS_LOG2(fmt, a1, a2) \
     do { \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2)); \
+      AUDIO_LOG_SOFT_EMIT2(fmt, a1, a2); \
     } \
     while (0)
 
 #define AUDIO_ALWAYS_LOG3(fmt, a1, a2, a3) \
     do { \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2), (a3)); \
+      AUDIO_LOG_SOFT_EMIT3(fmt, a1, a2, a3); \
     } \
     while (0)
 
 #define AUDIO_ALWAYS_LOG4(fmt, a1, a2, a3, a4) \
     do { \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2), (a3), (a4)); \
+      AUDIO_LOG_SOFT_EMIT4(fmt, a1, a2, a3, a4); \
     } \
     while (0)
 
 #define AUDIO_ALWAYS_LOG5(fmt, a1, a2, a3, a4, a5) \
     do { \
-      audio_log_soft(__FILE__,__LINE__, (fmt), (a1), (a2), (a3), (a4), (a5)); \
+      AUDIO_LOG_SOFT_EMIT5(fmt, a1, a2, a3, a4, a5); \
     } \
     while (0)
 
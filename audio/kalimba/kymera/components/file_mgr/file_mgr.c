@@ -98,8 +98,6 @@ static uint16 file_mgr_alloc_file( uint32 file_size,
             file_size_in_words = OCTETS_TO_CBUFFER_SIZE(file_size);
 
             /* allocate the file struct */
-            stored_files[file_idx] = pnew(DATA_FILE);
-
             file = xpnew(DATA_FILE);
             if (file == NULL)
             {
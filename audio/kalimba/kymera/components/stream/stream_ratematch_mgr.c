@@ -54,6 +54,31 @@ typedef enum {
 }
 RM_ENACT_RANK;
 
+/**
+ * One entry per distinct endpoint referenced by rm_list. Each decision period
+ * every clock source is sampled once and all the pairs it belongs to are fed
+ * from that sample.
+ */
+typedef struct
+{
+    /** The endpoint whose clock is sampled */
+    ENDPOINT *ep;
+
+    /** The endpoint is the non-enacting (reference) side of at least one
+     * pair, so its rate measurement is needed.
+     * \note 8-bit packing results in relatively efficient byte accesses */
+    bool is_reference   : 8;
+
+    /** meas holds a valid measurement for the current period */
+    bool meas_valid     : 8;
+
+    /** Result of EP_RATEMATCH_MEASUREMENT for the current period */
+    ENDPOINT_RATEMATCH_MEASUREMENT_RESULT meas;
+
+    /** Result of EP_RATEMATCH_RATE, updated every slow period */
+    int rate;
+} RATEMATCH_CLOCK;
+
 /**
  * Used to create a list of pairs of clock sources to ratematch between and the
  * endpoint responsible for applying the ratematch enacting.
@@ -63,6 +88,9 @@ typedef struct RATEMATCH_PAIR
     ENDPOINT *ep1;
     ENDPOINT *ep2;
     ENDPOINT *enacting_ep;
+    /** Entries for ep1 and ep2 in rm_clocks, NULL if it couldn't be built */
+    RATEMATCH_CLOCK *clk1;
+    RATEMATCH_CLOCK *clk2;
     struct RATEMATCH_PAIR *next;
 }RATEMATCH_PAIR;
 
@@ -120,6 +148,16 @@ DM_P0_RW_ZI static bool rm_timer_running = FALSE;
 /** Counter to divide faster to slower rate matching period. */
 DM_P0_RW_ZI static unsigned rm_timer_slow_period = 0;
 
+/** Clock sources referenced by rm_list, see RATEMATCH_CLOCK */
+DM_P0_RW_ZI static RATEMATCH_CLOCK *rm_clocks = NULL;
+
+/** Number of entries in rm_clocks */
+DM_P0_RW_ZI static unsigned rm_num_clocks = 0;
+
+/** Set whenever rm_list changes, the clock table is rebuilt lazily
+ * by the next decision rather than on every graph change. */
+DM_P0_RW_ZI static bool rm_clocks_stale = FALSE;
+
 /** The maximum number of operators find_graph_real_sources_and_sinks supports.
  * This is global so that it can be patched trivially. */
 DM_P0_RW static volatile unsigned max_operators = MAX_OPERATORS;
@@ -214,26 +252,174 @@ static int calc_diff(int rate1, int rate2)
 #endif /* __GNUC__ */
 
 
+/**
+ * \brief Get the EP_RATEMATCH_RATE of an endpoint.
+ *
+ * \param ep The endpoint to query
+ *
+ * \return The reported rate, or RM_PERFECT_RATE if the endpoint has none.
+ */
+static int get_ratematch_rate(ENDPOINT *ep)
+{
+    ENDPOINT_GET_CONFIG_RESULT res;
+    res.u.value = RM_PERFECT_RATE;
+
+    if (! ENDPOINT_GET_CONFIG(ep, EP_RATEMATCH_RATE, &res))
+    {
+        res.u.value = RM_PERFECT_RATE;
+    }
+    return (int)(int32)res.u.value;
+}
+
+/**
+ * \brief Get the rate measurement of an endpoint, using the sample taken
+ *        this period if there is one.
+ *
+ * \param ep The endpoint to query
+ * \param clk The clock table entry for ep, or NULL
+ * \param meas Location for the measurement
+ *
+ * \return TRUE if meas holds a valid measurement.
+ */
+static bool get_ratematch_measurement(ENDPOINT *ep, RATEMATCH_CLOCK *clk,
+                                      ENDPOINT_RATEMATCH_MEASUREMENT_RESULT *meas)
+{
+    ENDPOINT_GET_CONFIG_RESULT result;
+
+    if (clk != NULL)
+    {
+        *meas = clk->meas;
+        return clk->meas_valid;
+    }
+
+    if (ENDPOINT_GET_CONFIG(ep, EP_RATEMATCH_MEASUREMENT, &result)
+        && result.u.rm_meas.measurement.valid)
+    {
+        *meas = result.u.rm_meas;
+        return TRUE;
+    }
+    return FALSE;
+}
+
 /****************************************************************************
  * \brief
  */
-static int calc_missmatch(ENDPOINT *ep1, ENDPOINT *ep2)
+static int calc_missmatch(RATEMATCH_PAIR *pair)
+{
+    int rate1, rate2;
+
+    rate1 = (pair->clk1 != NULL) ? pair->clk1->rate : get_ratematch_rate(pair->ep1);
+    rate2 = (pair->clk2 != NULL) ? pair->clk2->rate : get_ratematch_rate(pair->ep2);
+
+    return calc_diff(rate1, rate2);
+}
+
+/**
+ * \brief Find or add the clock table entry for an endpoint.
+ *
+ * \param ep The endpoint
+ *
+ * \return The entry for ep. rm_clocks must have room for a new entry.
+ */
+static RATEMATCH_CLOCK *ratematch_clock_entry(ENDPOINT *ep)
 {
-    ENDPOINT_GET_CONFIG_RESULT res_ep1, res_ep2;
-    res_ep1.u.value = RM_PERFECT_RATE;
-    res_ep2.u.value = RM_PERFECT_RATE;
+    RATEMATCH_CLOCK *clk;
+    unsigned i;
 
-    if (! ENDPOINT_GET_CONFIG(ep1, EP_RATEMATCH_RATE, &res_ep1))
+    for (i = 0; i < rm_num_clocks; i++)
     {
-        res_ep1.u.value = RM_PERFECT_RATE;
+        if (rm_clocks[i].ep == ep)
+        {
+            return &rm_clocks[i];
+        }
+    }
+    clk = &rm_clocks[rm_num_clocks++];
+    clk->ep = ep;
+    clk->is_reference = FALSE;
+    clk->meas_valid = FALSE;
+    clk->rate = RM_PERFECT_RATE;
+    return clk;
+}
+
+/**
+ * \brief Rebuild the table of distinct clock sources referenced by rm_list
+ *        and point every pair at its entries. If the table can't be
+ *        allocated the pairs query their endpoints directly.
+ */
+static void ratematch_build_clocks(void)
+{
+    RATEMATCH_PAIR *pair;
+    unsigned num_pairs = 0;
+
+    patch_fn_shared(stream_ratematch);
+
+    pfree(rm_clocks);
+    rm_clocks = NULL;
+    rm_num_clocks = 0;
+    rm_clocks_stale = FALSE;
+
+    for (pair = rm_list; pair != NULL; pair = pair->next)
+    {
+        num_pairs++;
     }
-    if (! ENDPOINT_GET_CONFIG(ep2, EP_RATEMATCH_RATE, &res_ep2))
+    if (num_pairs > 0)
     {
-        res_ep2.u.value = RM_PERFECT_RATE;
+        /* At most two clocks per pair, usually far fewer as a reference
+         * tends to be shared by many pairs. */
+        rm_clocks = xpnewn(2 * num_pairs, RATEMATCH_CLOCK);
     }
 
-    return calc_diff((int)(int32)res_ep1.u.value, (int)(int32)res_ep2.u.value);
+    for (pair = rm_list; pair != NULL; pair = pair->next)
+    {
+        if (rm_clocks == NULL)
+        {
+            pair->clk1 = NULL;
+            pair->clk2 = NULL;
+            continue;
+        }
+        pair->clk1 = ratematch_clock_entry(pair->ep1);
+        pair->clk2 = ratematch_clock_entry(pair->ep2);
+        if (pair->enacting_ep == pair->ep1)
+        {
+            pair->clk2->is_reference = TRUE;
+        }
+        else
+        {
+            pair->clk1->is_reference = TRUE;
+        }
+    }
+
+    L2_DBG_MSG2("ratematch: %d pairs, %d clock sources", num_pairs, rm_num_clocks);
 }
+
+/**
+ * \brief Sample every clock source once for this decision period.
+ *
+ * Taking a measurement restarts it, so a reference shared by several pairs
+ * must only be measured once per period; every pair then sees the same
+ * measurement over the full period.
+ *
+ * \param read_rates Also refresh the EP_RATEMATCH_RATE values
+ */
+static void ratematch_sample_clocks(bool read_rates)
+{
+    unsigned i;
+
+    for (i = 0; i < rm_num_clocks; i++)
+    {
+        RATEMATCH_CLOCK *clk = &rm_clocks[i];
+
+        if (clk->is_reference)
+        {
+            clk->meas_valid = get_ratematch_measurement(clk->ep, NULL, &clk->meas);
+        }
+        if (read_rates)
+        {
+            clk->rate = get_ratematch_rate(clk->ep);
+        }
+    }
+}
+
 /****************************************************************************
  *  
  *  \brief Calculates the rate adjustment needed on the enacting endpoint based
@@ -252,29 +438,43 @@ static void ratematch_decision(void *data)
     {
         /* Indicate we are no running a timer for rate-match decisions */
         rm_timer_running = FALSE;
+        pfree(rm_clocks);
+        rm_clocks = NULL;
+        rm_num_clocks = 0;
+        rm_clocks_stale = FALSE;
         return;
     }
 
+    if (rm_clocks_stale)
+    {
+        ratematch_build_clocks();
+    }
+
+    /* Timestamp all the clock sources in one pass */
+    ratematch_sample_clocks(rm_timer_slow_period == 0);
+
     /* For every ratematching pair work out the differential rate and tell the
      * enacting endpoint. */
     for (pair = rm_list; pair != NULL; pair = pair->next)
     {
         ENDPOINT* non_enacting_ep;
+        RATEMATCH_CLOCK* non_enacting_clk;
+        ENDPOINT_RATEMATCH_MEASUREMENT_RESULT meas;
         if (pair->ep1 == pair->enacting_ep)
         {
             non_enacting_ep = pair->ep2;
+            non_enacting_clk = pair->clk2;
         }
         else
         {
             non_enacting_ep = pair->ep1;
+            non_enacting_clk = pair->clk1;
         }
-        ENDPOINT_GET_CONFIG_RESULT result;
-        if (ENDPOINT_GET_CONFIG(non_enacting_ep,EP_RATEMATCH_MEASUREMENT,&result)
-            && result.u.rm_meas.measurement.valid)
+        if (get_ratematch_measurement(non_enacting_ep, non_enacting_clk, &meas))
         {
             ENDPOINT_RATEMATCH_REFERENCE_PARAMS ref;
-            ref.sp_deviation = result.u.rm_meas.sp_deviation;
-            ref.ref = result.u.rm_meas.measurement;
+            ref.sp_deviation = meas.sp_deviation;
+            ref.ref = meas.measurement;
 
             /* Provide some information about the reference endpoint */
             ref.ref_endpoint_id = stream_external_id_from_endpoint(non_enacting_ep);
@@ -293,7 +493,7 @@ static void ratematch_decision(void *data)
             continue;
         }
 
-        int32 diff = (int32)calc_missmatch(pair->ep1, pair->ep2);
+        int32 diff = (int32)calc_missmatch(pair);
         ENDPOINT_CONFIGURE(pair->enacting_ep, EP_RATEMATCH_ADJUSTMENT,
                            (uint32)diff);
     }
@@ -1174,6 +1374,8 @@ static bool create_pair(ENDPOINT *enacting, ENDPOINT *non_enacting)
     }
 
     new_pair->enacting_ep = enacting;
+    new_pair->clk1 = NULL;
+    new_pair->clk2 = NULL;
     if (SINK == enacting->direction)
     {
         new_pair->ep2 = enacting;
@@ -1194,6 +1396,7 @@ static bool create_pair(ENDPOINT *enacting, ENDPOINT *non_enacting)
     /* Add the new element to the list */
     new_pair->next = rm_list;
     rm_list = new_pair;
+    rm_clocks_stale = TRUE;
     return TRUE;
 }
 
@@ -1413,6 +1616,7 @@ static void remove_rm_pairs(ENDPOINT_LIST *remove_list)
                 ratematch_undo_point_to_head(fnd_pair->enacting_ep);
 
                 pdelete(fnd_pair);
+                rm_clocks_stale = TRUE;
                 /* It's possible at this point that rm_list is empty at this point
                  * and we could stop the background timer here. But it will disable
                  * itself if it finds that the list has emptied so just let it
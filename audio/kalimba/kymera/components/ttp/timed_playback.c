@@ -73,6 +73,43 @@ typedef struct current_metadata_tag_struct
     bool is_void;
 }current_metadata_tag ;
 
+/**
+ * Buffer operations the timed playback uses to correct the playback error.
+ */
+typedef enum
+{
+    /** Nothing pending. */
+    CORRECTION_NONE = 0,
+    /** Discard samples from the input buffers. */
+    CORRECTION_DISCARD = 1,
+    /** Write silence to the output buffers. */
+    CORRECTION_SILENCE = 2,
+    /** Copy samples from the input to the output buffers. */
+    CORRECTION_COPY = 3,
+    /** Run the cbops chain (or HW warp) with a fixed rate adjustment. */
+    CORRECTION_RATE_ADJUST = 4
+} correction_type;
+
+/**
+ * A buffer operation decided on by the tag handling but not yet applied.
+ *
+ * Consecutive operations of the same kind (and, for rate adjustment, the same
+ * warp) are merged, so that a whole period is usually applied with one
+ * discard/fill per channel, one run of the cbops chain and one chain reset
+ * instead of one of each for every (reframed) tag.
+ */
+typedef struct
+{
+    /** Kind of operation pending. */
+    correction_type type;
+
+    /** Number of samples the operation applies to. */
+    unsigned samples;
+
+    /** Warp to use for CORRECTION_RATE_ADJUST. */
+    int warp;
+} pending_correction;
+
 
 
 struct TIMED_PLAYBACK_STRUCT
@@ -177,6 +214,12 @@ struct TIMED_PLAYBACK_STRUCT
      * Callback structure for sending an unachievable latency unsolicited message
      */
     ttp_unachv_lat_callback_struct cback;
+
+    /**
+     * Correction waiting to be applied to the buffers. The metadata is always
+     * consumed straight away, only the buffer operations are deferred.
+     */
+    pending_correction pending;
 };
 
 
@@ -273,6 +316,7 @@ static bool timed_playback_tag_on_time(TIMED_PLAYBACK* timed_pb, TIME_INTERVAL e
 static void timed_playback_discard_samples(TIMED_PLAYBACK* timed_pb, unsigned samples_to_discard);
 static void timed_playback_insert_silence(TIMED_PLAYBACK* timed_pb, unsigned silence_samples);
 static void ttp_reset_cbops_chain(TIMED_PLAYBACK* timed_pb);
+static void timed_playback_flush_correction(TIMED_PLAYBACK* timed_pb);
 
 /****************************************************************************
 Private Function Definitions
@@ -302,6 +346,11 @@ static unsigned ttp_output_buffers_space(TIMED_PLAYBACK* timed_pb)
             retval = current;
         }
     }
+    /* Space already claimed by the pending correction. */
+    if (timed_pb->pending.type != CORRECTION_DISCARD)
+    {
+        retval = SUBTRACT_SAMPLES(retval, timed_pb->pending.samples);
+    }
     return retval;
 }
 
@@ -325,6 +374,11 @@ static unsigned ttp_output_buffers_data(TIMED_PLAYBACK* timed_pb)
             retval = current;
         }
     }
+    /* Data the pending correction is going to write. */
+    if (timed_pb->pending.type != CORRECTION_DISCARD)
+    {
+        retval += timed_pb->pending.samples;
+    }
     return retval;
 }
 
@@ -348,6 +402,11 @@ static unsigned ttp_input_buffers_data(TIMED_PLAYBACK* timed_pb)
             retval = current;
         }
     }
+    /* Data the pending correction is going to read. */
+    if (timed_pb->pending.type != CORRECTION_SILENCE)
+    {
+        retval = SUBTRACT_SAMPLES(retval, timed_pb->pending.samples);
+    }
 
     /* Check the available octets in the metadata because it can be different if
      * the timed playback module (which is running in interrupt level) interrupts an
@@ -361,6 +420,114 @@ static unsigned ttp_input_buffers_data(TIMED_PLAYBACK* timed_pb)
     return retval;
 }
 
+/**
+ * \brief Applies the pending correction to the buffers of all channels.
+ *
+ * \param timed_pb - Pointer to the timed_pb playback instance
+ */
+static void timed_playback_flush_correction(TIMED_PLAYBACK* timed_pb)
+{
+    correction_type type = timed_pb->pending.type;
+    unsigned samples = timed_pb->pending.samples;
+    int warp = timed_pb->pending.warp;
+    unsigned channel;
+#ifdef TTP_BUFFER_DEBUG
+    unsigned amount_before = ttp_input_buffers_data(timed_pb);
+#endif
+
+    patch_fn_shared(timed_playback);
+
+    /* Clear the pending state first, the buffer helpers take it into account. */
+    timed_pb->pending.type = CORRECTION_NONE;
+    timed_pb->pending.samples = 0;
+
+    if (samples == 0)
+    {
+        return;
+    }
+
+    switch (type)
+    {
+        case CORRECTION_DISCARD:
+            for (channel = 0; channel < timed_pb->used_channels; channel++)
+            {
+                cbuffer_discard_data(timed_pb->in_buffers[channel], samples);
+            }
+            /* The input buffer of the cbops chain has been modified. Reset the chain. */
+            ttp_reset_cbops_chain(timed_pb);
+            break;
+
+        case CORRECTION_SILENCE:
+            for (channel = 0; channel < timed_pb->used_channels; channel++)
+            {
+                cbuffer_block_fill(timed_pb->out_buffers[channel], samples, 0);
+            }
+            /* The output buffer of the cbops chain has been modified. Reset the chain. */
+            ttp_reset_cbops_chain(timed_pb);
+            break;
+
+        case CORRECTION_COPY:
+            for (channel = 0; channel < timed_pb->used_channels; channel++)
+            {
+                cbuffer_copy(timed_pb->out_buffers[channel], timed_pb->in_buffers[channel], samples);
+            }
+            /* The output buffer of the cbops chain has been modified. Reset the chain. */
+            ttp_reset_cbops_chain(timed_pb);
+            break;
+
+        case CORRECTION_RATE_ADJUST:
+            if (timed_pb->do_hw_warp)
+            {
+                timed_pb->rate_adjust(timed_pb->rm_data, warp);
+            }
+            else
+            {
+                /* Make sure the sra is not in passthrough mode  */
+                cbops_mgr_rateadjust_passthrough_mode(timed_pb->cbops_manager, FALSE);
+
+                /* Set the SRA */
+                cbops_sra_set_rate_adjust(timed_pb->rate_adjustment, timed_pb->nr_of_channels, warp);
+            }
+            /* ... and finally, run the cbops chain once for the whole block. */
+            cbops_mgr_process_data(timed_pb->cbops_manager, samples);
+            break;
+
+        default:
+            PL_ASSERT(FALSE);
+            break;
+    }
+
+#ifdef TTP_BUFFER_DEBUG
+    TTP_DBG_MSG5("TTP Playback 0x%08x: correction %d applied to %4d samples, input data before = %4d, after = %4d",
+            (uintptr_t)timed_pb, type, samples,
+            amount_before, ttp_input_buffers_data(timed_pb));
+#endif
+}
+
+/**
+ * \brief Adds a buffer operation to the pending correction. If it can't be merged
+ *        with the one already pending, that one is applied first.
+ *
+ * \param timed_pb - Pointer to the timed_pb playback instance
+ * \param type - The buffer operation.
+ * \param samples - Number of samples the operation applies to.
+ * \param warp - Rate adjustment for CORRECTION_RATE_ADJUST, ignored otherwise.
+ */
+static void timed_playback_queue_correction(TIMED_PLAYBACK* timed_pb, correction_type type,
+        unsigned samples, int warp)
+{
+    pending_correction *pending = &timed_pb->pending;
+
+    if ((pending->type != type) ||
+        ((type == CORRECTION_RATE_ADJUST) && (pending->warp != warp)))
+    {
+        timed_playback_flush_correction(timed_pb);
+        pending->type = type;
+        pending->warp = warp;
+    }
+    pending->samples += samples;
+}
+
 #if defined(DBG_USE_CBUFFER) || !defined(USE_SILENCE_INSERTION)
 /**
 * \brief Function copy samples in all channels.
@@ -370,14 +537,7 @@ static unsigned ttp_input_buffers_data(TIMED_PLAYBACK* timed_pb)
 */
 static void ttp_buffer_copy(TIMED_PLAYBACK* timed_pb, unsigned samples_to_copy)
 {
-    unsigned channel;
-    for (channel = 0;channel < timed_pb->used_channels; channel++)
-    {
-        cbuffer_copy(timed_pb->out_buffers[channel], timed_pb->in_buffers[channel], samples_to_copy);
-    }
-
-    /* The output buffer of the cbops chain has been modified. Reset the chain. */
-    ttp_reset_cbops_chain(timed_pb);
+    timed_playback_queue_correction(timed_pb, CORRECTION_COPY, samples_to_copy, 0);
 }
 #endif
 
@@ -390,14 +550,7 @@ static void ttp_buffer_copy(TIMED_PLAYBACK* timed_pb, unsigned samples_to_copy)
 */
 static void ttp_buffer_discard(TIMED_PLAYBACK* timed_pb, unsigned samples_to_discard)
 {
-    unsigned channel;
-    for (channel = 0;channel < timed_pb->used_channels; channel++)
-    {
-        cbuffer_discard_data(timed_pb->in_buffers[channel], samples_to_discard);
-    }
-
-    /* The output buffer of the cbops chain has been modified. Reset the chain. */
-    ttp_reset_cbops_chain(timed_pb);
+    timed_playback_queue_correction(timed_pb, CORRECTION_DISCARD, samples_to_discard, 0);
 }
 #endif
 
@@ -466,12 +619,22 @@ static void check_input_buff_read_index_validity(TIMED_PLAYBACK *timed_pb)
     static unsigned int read_index = 0;
     static unsigned meta_index = 0;
     tCbuffer *metadata_buff = timed_pb->in_buffers[0];
+    unsigned pending_read = 0;
 
     read_index = (uintptr_t)metadata_buff->read_ptr - (uintptr_t)metadata_buff->base_addr;
 
     /*Convert the adresses to words. */
     read_index = read_index >> LOG2_ADDR_PER_WORD;
 
+    /* The metadata is consumed straight away, the buffers only once the pending
+     * correction is applied. Account for what it is going to read. */
+    if ((timed_pb->pending.type != CORRECTION_NONE) &&
+        (timed_pb->pending.type != CORRECTION_SILENCE))
+    {
+        pending_read = timed_pb->pending.samples;
+    }
+    read_index = (read_index + pending_read) % cbuffer_get_size_in_words(metadata_buff);
+
     /* Convert the words to usable octets. */
     read_index = read_index * OCTETS_PER_SAMPLE;
 
@@ -518,23 +681,15 @@ static void  timed_playback_do_rate_adjust(TIMED_PLAYBACK* timed_pb, unsigned sa
 #else
     patch_fn_shared(timed_playback);
 
-    if (timed_pb->do_hw_warp)
-    {
-        timed_pb->rate_adjust(timed_pb->rm_data, timed_pb->pid_state.warp);
-    }
-    else
-    {
-        /* Make sure the sra is not in passthrough mode  */
-        cbops_mgr_rateadjust_passthrough_mode(timed_pb->cbops_manager, FALSE);
-
-        /* Set the SRA */
-        cbops_sra_set_rate_adjust(timed_pb->rate_adjustment,timed_pb->nr_of_channels, timed_pb->pid_state.warp);
-    }
-    /* ... and finally, run the cbops chain. */
-    cbops_mgr_process_data(timed_pb->cbops_manager, samples_to_play);
+    /* Consecutive blocks played with the same warp are run through the
+     * cbops chain in one go. */
+    timed_playback_queue_correction(timed_pb, CORRECTION_RATE_ADJUST, samples_to_play,
+            timed_pb->pid_state.warp);
 #endif
 
 #ifdef TTP_BUFFER_DEBUG
+    /* The space helpers count the pending correction, so this is the space
+     * once the block has been played. */
     amount_of_space_after = ttp_output_buffers_space(timed_pb);
     TTP_DBG_MSG5("TTP Playback sra 0x%08x: samples to copy = %4d, with sra = 0x%08x, space before = %4d, space after = %4d",
             (uintptr_t)timed_pb, samples_to_play, timed_pb->pid_state.warp,
@@ -797,20 +952,14 @@ static void  timed_playback_discard_samples(TIMED_PLAYBACK* timed_pb, unsigned s
     unsigned amount_of_data_after;
 #endif
 
-    unsigned channel;
-
     patch_fn_shared(timed_playback);
 
     TTP_WARN_MSG4("TTP sample discard, playback time = %d samples = %d spa = %d error = %d",
         timed_pb->current_tag.playback_time, samples_to_discard, timed_pb->current_tag.sp_adjust, timed_pb->current_tag.error);
 
-    for (channel = 0;channel < timed_pb->used_channels; channel++)
-    {
-        cbuffer_discard_data(timed_pb->in_buffers[channel], samples_to_discard);
-    }
-
-    /* The input buffer of the cbops chain has been modified. Reset the chain. */
-    ttp_reset_cbops_chain(timed_pb);
+    /* Discards spanning several tags are applied to the buffers (and the cbops
+     * chain reset) only once. */
+    timed_playback_queue_correction(timed_pb, CORRECTION_DISCARD, samples_to_discard, 0);
 
 #ifdef TTP_BUFFER_DEBUG
     amount_of_data_after = ttp_input_buffers_data(timed_pb);
@@ -844,9 +993,11 @@ static bool timed_playback_tag_late(TIMED_PLAYBACK* timed_pb, TIME_INTERVAL erro
     patch_fn_shared(timed_playback);
 
     /* Reset the PID controller, the rate adjustment and set the error limit lower now
-     * that samples will be discarded.*/
+     * that samples will be discarded. Anything played so far must go through the
+     * chain before it is reset. */
     timed_pb->error_limit = WARP_TIGHT_LIMIT;
     timed_reset_pid_controller(&timed_pb->pid_state);
+    timed_playback_flush_correction(timed_pb);
     ttp_reset_cbops_chain(timed_pb);
 
     /* Calculate the available data in the input buffer. */
@@ -914,16 +1065,9 @@ static void  timed_playback_insert_silence(TIMED_PLAYBACK* timed_pb, unsigned si
     unsigned amount_of_space_after;
 #endif
 
-    unsigned channel;
-
     patch_fn_shared(timed_playback);
-    for (channel = 0;channel < timed_pb->used_channels; channel++)
-    {
-        cbuffer_block_fill(timed_pb->out_buffers[channel], silence_samples, 0);
-    }
 
-    /* The output buffer of the cbops chain has been modified. Reset the chain. */
-    ttp_reset_cbops_chain(timed_pb);
+    timed_playback_queue_correction(timed_pb, CORRECTION_SILENCE, silence_samples, 0);
 
 #ifdef TTP_BUFFER_DEBUG
     amount_of_space_after = ttp_output_buffers_space(timed_pb);
@@ -1365,6 +1509,9 @@ void timed_playback_run(TIMED_PLAYBACK *timed_pb)
     /* Insert silence if there is not enough data until the next run. */
     avoid_buffer_wrap(timed_pb);
 
+    /* Apply whatever correction is still pending to the buffers. */
+    timed_playback_flush_correction(timed_pb);
+
 #ifdef TTP_DEBUG
     DYN_PROFILER_STOP("timed_playback_run",(uintptr_t)timed_pb);
 #endif
@@ -51,6 +51,8 @@ struct ttp_context
     TIME_INTERVAL max_latency;
     TIME prev_source_time;
     int ttp_frac;
+    ttp_kalman kalman;
+    unsigned estimator_updates;
 };
 
 
@@ -85,6 +87,13 @@ Private Macro Declarations
 /* Minimum startup countdown period */
 #define MIN_COUNTDOWN (10 * MILLISECOND)
 
+/* Default steady state memory of the Kalman estimator, in updates */
+#define DEFAULT_ESTIMATOR_MEMORY 1024
+
+/* Optional words after the standard OPMSG_COMMON_SET_TTP_PARAMS fields */
+#define TTP_PARAMS_ESTIMATOR_WORD_OFFSET        (OPMSG_COMMON_MSG_SET_TTP_PARAMS_WORD_SIZE)
+#define TTP_PARAMS_ESTIMATOR_MEMORY_WORD_OFFSET (OPMSG_COMMON_MSG_SET_TTP_PARAMS_WORD_SIZE + 1)
+
 /* Some constants lifted from Broadcast Audio code */
 #define LATENCY_STEP_LIMIT -2000
 #define LATENCY_LEAK_FACTOR (FRACTIONAL(0.999))
@@ -134,6 +143,40 @@ static void calc_filtered_error(ttp_context *context, TIME_INTERVAL raw_error)
         frac_mul_long((int48)raw_error << DAWTH, FRACTIONAL(1.0)-context->params.filter_gain);
 }
 
+/**
+ * update_sp_adjustment
+ *
+ * \brief  Run the selected estimator and update the SP adjustment
+ *
+ */
+static void update_sp_adjustment(ttp_context *context, TIME_INTERVAL raw_error, TIME_INTERVAL dt)
+{
+    if (context->params.estimator == TTP_ESTIMATOR_KALMAN)
+    {
+        context->sp_adjustment = ttp_kalman_update(&context->kalman, raw_error, dt, context->sp_adjustment);
+    }
+    else
+    {
+        calc_filtered_error(context, raw_error);
+        /* 
+         * Convert the filtered error to SP adjustment
+         * We assume the scaling factor is small enough that the resulting value fits in a single word
+         */
+        context->sp_adjustment = (int)(frac_mul_long(context->filtered_error, context->params.err_scale));
+    }
+    context->estimator_updates++;
+
+    /* Limit SP adjustment to +/- 0.5% */
+    if (context->sp_adjustment > FRACTIONAL(0.005)) 
+    {
+        context->sp_adjustment = FRACTIONAL(0.005);
+    }
+    if (context->sp_adjustment < -FRACTIONAL(0.005)) 
+    {
+        context->sp_adjustment = -FRACTIONAL(0.005);
+    }
+}
+
 /**
  * get_msg_fractional
  *
@@ -176,6 +219,10 @@ ttp_context *ttp_init(void)
          * so the playback control can adjust the initial timestamps
          */
         context->adj_info_id = ttp_info_create(&context->error_offset);
+
+        context->params.estimator = TTP_ESTIMATOR_FILTER;
+        context->params.estimator_memory = DEFAULT_ESTIMATOR_MEMORY;
+        ttp_kalman_init(&context->kalman, DEFAULT_ESTIMATOR_MEMORY);
     }
     
     return context;
@@ -203,6 +250,7 @@ void ttp_reset(ttp_context *context)
     context->error_offset = 0;
     context->ttp_frac = 0;
     context->prev_source_time = 0;
+    ttp_kalman_restart(&context->kalman);
 }
 
 
@@ -221,6 +269,8 @@ void ttp_get_default_params(ttp_params *params, ttp_source_type source_type)
     params->filter_gain = DEFAULT_FILT_GAIN;
     params->err_scale = DEFAULT_ERR_SCALE;
     params->nominal_sample_rate = stream_if_get_system_sampling_rate();
+    params->estimator = TTP_ESTIMATOR_FILTER;
+    params->estimator_memory = DEFAULT_ESTIMATOR_MEMORY;
 }
 
 /**
@@ -278,6 +328,26 @@ void ttp_get_msg_params(ttp_params *params, void *message_data)
     params->err_scale = get_msg_fractional(OPMSG_FIELD_GET(message_data, OPMSG_COMMON_MSG_SET_TTP_PARAMS, ERROR_SCALE_MS),
                                            OPMSG_FIELD_GET(message_data, OPMSG_COMMON_MSG_SET_TTP_PARAMS, ERROR_SCALE_LS));
     params->startup_period = (TIME_INTERVAL)(OPMSG_FIELD_GET(message_data, OPMSG_COMMON_MSG_SET_TTP_PARAMS, STARTUP_TIME) * MILLISECOND);
+
+    /* Optional estimator selection, appended to the standard message.
+     * Without it the current estimator is kept. */
+    params->estimator = TTP_ESTIMATOR_UNCHANGED;
+    params->estimator_memory = 0;
+    if (OPMGR_GET_OPMSG_LENGTH((OP_MSG_REQ *)message_data) > TTP_PARAMS_ESTIMATOR_WORD_OFFSET)
+    {
+        if (OPMSG_FIELD_GET_FROM_OFFSET(message_data, TTP_PARAMS, ESTIMATOR, 0) == TTP_ESTIMATOR_KALMAN)
+        {
+            params->estimator = TTP_ESTIMATOR_KALMAN;
+        }
+        else
+        {
+            params->estimator = TTP_ESTIMATOR_FILTER;
+        }
+    }
+    if (OPMGR_GET_OPMSG_LENGTH((OP_MSG_REQ *)message_data) > TTP_PARAMS_ESTIMATOR_MEMORY_WORD_OFFSET)
+    {
+        params->estimator_memory = OPMSG_FIELD_GET_FROM_OFFSET(message_data, TTP_PARAMS, ESTIMATOR_MEMORY, 0);
+    }
 }
 
 /**
@@ -333,6 +403,23 @@ void ttp_configure_params(ttp_context *context, const ttp_params *params)
         temp_params.nominal_sample_rate = context->params.nominal_sample_rate;
     }
 
+    /* Likewise for the estimator settings left out of the message */
+    if (temp_params.estimator == TTP_ESTIMATOR_UNCHANGED)
+    {
+        temp_params.estimator = context->params.estimator;
+    }
+    if (temp_params.estimator_memory == 0)
+    {
+        temp_params.estimator_memory = context->params.estimator_memory;
+    }
+
+    /* A new estimator configuration starts from scratch */
+    if ((temp_params.estimator != context->params.estimator) ||
+        (temp_params.estimator_memory != context->params.estimator_memory))
+    {
+        ttp_kalman_init(&context->kalman, temp_params.estimator_memory);
+    }
+
     context->params = temp_params;
 }
 
@@ -507,22 +594,7 @@ void ttp_update_ttp_from_source_time(ttp_context *context, TIME toa, TIME source
 
     if (context->state == TTP_STATE_RUNNING)
     {
-        calc_filtered_error(context, raw_error);
-        /* 
-         * Convert the filtered error to SP adjustment
-         * We assume the scaling factor is small enough that the resulting value fits in a single word
-         */
-        context->sp_adjustment = (int)(frac_mul_long(context->filtered_error, context->params.err_scale));
-
-        /* Limit SP adjustment to +/- 0.5% */
-        if (context->sp_adjustment > FRACTIONAL(0.005)) 
-        {
-            context->sp_adjustment = FRACTIONAL(0.005);
-        }
-        if (context->sp_adjustment < -FRACTIONAL(0.005)) 
-        {
-            context->sp_adjustment = -FRACTIONAL(0.005);
-        }
+        update_sp_adjustment(context, raw_error, time_delta);
     }
 
     /* Populate the status structure provided by the caller */
@@ -555,6 +627,8 @@ void ttp_update_ttp_from_source_time(ttp_context *context, TIME toa, TIME source
 void ttp_update_ttp(ttp_context *context, TIME time, unsigned samples, ttp_status *status)
 {
     TIME_INTERVAL raw_error = 0;
+    /* Duration of the previous block, i.e. the time since the last update */
+    TIME_INTERVAL block_time = (TIME_INTERVAL)context->delta;
     uint32 period_adj;
 
     patch_fn_shared(ttp_gen);
@@ -689,22 +763,7 @@ void ttp_update_ttp(ttp_context *context, TIME time, unsigned samples, ttp_statu
 
     if (context->state == TTP_STATE_RUNNING)
     {
-        calc_filtered_error(context, raw_error);
-        /* 
-         * Convert the filtered error to SP adjustment
-         * We assume the scaling factor is small enough that the resulting value fits in a single word
-         */
-        context->sp_adjustment = (int)(frac_mul_long(context->filtered_error, context->params.err_scale));
-
-        /* Limit SP adjustment to +/- 0.5% */
-        if (context->sp_adjustment > FRACTIONAL(0.005)) 
-        {
-            context->sp_adjustment = FRACTIONAL(0.005);
-        }
-        if (context->sp_adjustment < -FRACTIONAL(0.005)) 
-        {
-            context->sp_adjustment = -FRACTIONAL(0.005);
-        }
+        update_sp_adjustment(context, raw_error, block_time);
     }
 
     /* Populate the status structure provided by the caller */
@@ -763,6 +822,27 @@ int ttp_get_sp_adjustment(ttp_context *context)
     return context->sp_adjustment;
 }
 
+/**
+ * ttp_get_estimator_state
+ *
+ * \brief  Get the state of the sample period adjustment estimator
+ */
+void ttp_get_estimator_state(ttp_context *context, ttp_estimator_state *state)
+{
+    state->type = context->params.estimator;
+    if (context->params.estimator == TTP_ESTIMATOR_KALMAN)
+    {
+        ttp_kalman_get_state(&context->kalman, state);
+    }
+    else
+    {
+        state->offset = (TIME_INTERVAL)((int48)context->filtered_error >> DAWTH);
+        state->drift = 0;
+        state->innovation = 0;
+        state->updates = context->estimator_updates;
+    }
+}
+
 /*
  * ttp_get_next_timestamp
  * 
@@ -28,6 +28,19 @@ typedef struct
 }
 ttp_status;
 
+/**
+ * Sample period adjustment estimators
+ */
+typedef enum
+{
+    /** Low-pass filtered latency error scaled to an adjustment */
+    TTP_ESTIMATOR_FILTER = 0,
+    /** Joint offset and drift (Kalman / least-squares) estimator */
+    TTP_ESTIMATOR_KALMAN = 1,
+    /** Only in parameters passed to ttp_configure_params: keep the current one */
+    TTP_ESTIMATOR_UNCHANGED = 2
+} ttp_estimator_type;
+
 /** 
  * Parameters structure
  * Various configurable values affecting the TTP generation
@@ -38,9 +51,25 @@ typedef struct
     unsigned        filter_gain;
     unsigned        err_scale;
     TIME_INTERVAL   startup_period;
+    ttp_estimator_type estimator;       /**< Sample period adjustment estimator */
+    unsigned        estimator_memory;   /**< Kalman: updates averaged over in steady state,
+                                             zero to keep the current value */
 }
 ttp_params;
 
+/**
+ * Estimator state, see ttp_get_estimator_state
+ */
+typedef struct
+{
+    ttp_estimator_type type;            /**< Estimator in use */
+    TIME_INTERVAL   offset;             /**< Estimated latency error, in us */
+    int             drift;              /**< Estimated source rate mismatch (fractional) */
+    TIME_INTERVAL   innovation;         /**< Last measurement vs. prediction, in us */
+    unsigned        updates;            /**< Number of estimator updates since init */
+}
+ttp_estimator_state;
+
 typedef enum 
 {
     TTP_TYPE_NONE,
@@ -116,7 +145,10 @@ extern void ttp_get_msg_latency_limits(void *message_data, TIME_INTERVAL *min_la
  * \param  message_data   pointer to message payload
  *
  * Helper function to extract the parameter values from 
- * a received OPMSG_COMMON_SET_TTP_PARAMS message
+ * a received OPMSG_COMMON_SET_TTP_PARAMS message.
+ * The message may carry two optional words after the standard fields:
+ * the estimator type (ttp_estimator_type) and the estimator memory length.
+ * If they are absent the estimator configuration is left as it is.
  */
 extern void ttp_get_msg_params(ttp_params *params, void *message_data);
 
@@ -237,6 +269,18 @@ extern void ttp_continue_ttp(ttp_context *context, unsigned samples, ttp_status
  */
 extern int ttp_get_sp_adjustment(ttp_context *context);
 
+/**
+ * \brief  Get the state of the sample period adjustment estimator
+ *
+ * \param  context   pointer to active TTP context structure
+ *
+ * \param  state   pointer to structure to populate
+ *
+ * For the filter estimator only type, offset (the filtered error)
+ * and updates are meaningful.
+ */
+extern void ttp_get_estimator_state(ttp_context *context, ttp_estimator_state *state);
+
 
 /**
  * \brief Function calculates the timestamp for a new tag based on a previous tag.
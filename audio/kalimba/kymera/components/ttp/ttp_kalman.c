@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+ *
+ * \file  ttp_kalman.c
+ *
+ * \ingroup ttp
+ *
+ * Time-to-play (TTP) offset and drift estimator
+ *
+ * Alternative to the fixed low-pass filter in ttp.c. The latency error is
+ * modelled as
+ *
+ *     error[k] = error[k-1] + dt * (sp_adjust[k-1] - drift)
+ *
+ * where sp_adjust is the sample period adjustment applied by the TTP
+ * generator during the last block and drift is the (unknown) rate mismatch
+ * between the source and the local clock. Offset and drift are tracked
+ * jointly with a two-state Kalman filter for this constant-velocity model.
+ *
+ * The filter runs with the gains of the expanding-memory least-squares fit,
+ * which are the Kalman gains for an uninformative prior:
+ *
+ *     alpha[n] = 2 * (2n - 1) / (n * (n + 1))
+ *     beta[n]  = 6 / (n * (n + 1))
+ *
+ * Once n reaches the configured memory length the gains are frozen, giving
+ * the steady-state (alpha-beta) filter. This converges much faster after a
+ * (re)start than a fixed-gain filter tuned for steady-state jitter, and the
+ * drift estimate survives stream restarts, so a re-buffer only needs to
+ * re-learn the offset.
+ *
+ * Everything is fixed point: the offset is kept in microseconds scaled by
+ * 2^KALMAN_OFFSET_SHIFT, drift and sp_adjust are fractional.
+ */
+
+/****************************************************************************
+Include Files
+*/
+
+#include "ttp_private.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Fractional bits of the offset estimate */
+#define KALMAN_OFFSET_SHIFT 8
+
+/** Gains to start from after ttp_kalman_init. Skips the first, degenerate,
+ *  steps of the expanding memory fit which would trust a single jittery
+ *  arrival time completely. */
+#define KALMAN_INITIAL_HISTORY 4
+
+/** Gains to start from after a restart, when the drift is still valid. */
+#define KALMAN_RESTART_HISTORY 16
+
+/** Innovations larger than this (in us) are clipped, so that a single badly
+ *  delayed packet doesn't drag the estimate. */
+#define KALMAN_INNOVATION_LIMIT (5 * MILLISECOND)
+
+/** No clock pair we support drifts anywhere near this much, so limit the
+ *  estimate to it to bound the transients of the first few updates. */
+#define KALMAN_DRIFT_LIMIT (FRACTIONAL(0.01))
+
+/** Time over which the offset estimate is corrected by the sp adjustment */
+#define KALMAN_CORRECTION_TIME (1 * SECOND)
+
+/****************************************************************************
+Private Macro Declarations
+*/
+
+/** Limits A between [L,U] */
+#define KALMAN_CLAMP(A, L, U)  MIN(MAX((A), (L)),(U))
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/**
+ * \brief  Divide a value in (scaled) microseconds by a time interval,
+ *         giving a fractional result.
+ *
+ * \param  num     Numerator, in us << KALMAN_OFFSET_SHIFT
+ * \param  mult    Extra integer multiplier for the numerator
+ * \param  denom   Denominator, in us (times any integer factor)
+ *
+ * \return  mult * num / denom as a fractional
+ */
+static int kalman_ratio(int num, int mult, int48 denom)
+{
+    int48 result;
+
+    if (denom <= 0)
+    {
+        return 0;
+    }
+    result = (((int48)num * mult) << (DAWTH - 1 - KALMAN_OFFSET_SHIFT)) / denom;
+
+    /* Anything near the limits is far beyond the +/- 0.5% the caller allows */
+    return (int)KALMAN_CLAMP(result, -FRACTIONAL(0.5), FRACTIONAL(0.5));
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/*
+ * ttp_kalman_init
+ */
+void ttp_kalman_init(ttp_kalman *kalman, unsigned memory)
+{
+    kalman->memory = MAX(memory, KALMAN_INITIAL_HISTORY);
+    kalman->offset = 0;
+    kalman->drift = 0;
+    kalman->innovation = 0;
+    kalman->history = KALMAN_INITIAL_HISTORY;
+    kalman->updates = 0;
+}
+
+/*
+ * ttp_kalman_restart
+ */
+void ttp_kalman_restart(ttp_kalman *kalman)
+{
+    /* The drift is a property of the clocks, not of the stream, so keep it
+     * and only forget the offset. */
+    kalman->offset = 0;
+    kalman->innovation = 0;
+    if (kalman->updates == 0)
+    {
+        kalman->history = KALMAN_INITIAL_HISTORY;
+    }
+    else
+    {
+        kalman->history = MIN(KALMAN_RESTART_HISTORY, kalman->memory);
+    }
+}
+
+/*
+ * ttp_kalman_update
+ */
+int ttp_kalman_update(ttp_kalman *kalman, TIME_INTERVAL raw_error, TIME_INTERVAL dt, int sp_adjust)
+{
+    int predicted, innovation, limit;
+    int48 n = (int48)kalman->history;
+    int48 gain_denom = n * (n + 1);
+
+    patch_fn_shared(ttp_gen);
+
+    /* Predict the error from the adjustment applied during the last block */
+    predicted = kalman->offset + frac_mult(dt << KALMAN_OFFSET_SHIFT, sp_adjust - kalman->drift);
+
+    /* Compare with the measurement, clipping outliers */
+    innovation = (raw_error << KALMAN_OFFSET_SHIFT) - predicted;
+    limit = KALMAN_INNOVATION_LIMIT << KALMAN_OFFSET_SHIFT;
+    innovation = KALMAN_CLAMP(innovation, -limit, limit);
+
+    /* Correct offset and drift */
+    kalman->offset = predicted + (int)(((int48)innovation * 2 * (2 * n - 1)) / gain_denom);
+    if (dt > 0)
+    {
+        /* A growing error means the source runs slower than assumed */
+        kalman->drift -= kalman_ratio(innovation, 6, gain_denom * dt);
+        kalman->drift = KALMAN_CLAMP(kalman->drift, -KALMAN_DRIFT_LIMIT, KALMAN_DRIFT_LIMIT);
+    }
+    kalman->innovation = innovation;
+
+    /* Expand the memory until the steady state gains are reached */
+    if (kalman->history < kalman->memory)
+    {
+        kalman->history++;
+    }
+    kalman->updates++;
+
+    /* Cancel the drift and steer the offset back to zero */
+    return kalman->drift - kalman_ratio(kalman->offset, 1, KALMAN_CORRECTION_TIME);
+}
+
+/*
+ * ttp_kalman_get_state
+ */
+void ttp_kalman_get_state(const ttp_kalman *kalman, ttp_estimator_state *state)
+{
+    state->offset = kalman->offset >> KALMAN_OFFSET_SHIFT;
+    state->drift = kalman->drift;
+    state->innovation = kalman->innovation >> KALMAN_OFFSET_SHIFT;
+    state->updates = kalman->updates;
+}
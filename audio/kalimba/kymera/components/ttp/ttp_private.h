@@ -33,6 +33,54 @@
 #include "hydra_modules/mib/mib.h"
 #include "audio_log/audio_log.h"
 
+/**
+ * State of the offset and drift estimator (ttp_kalman.c)
+ */
+typedef struct
+{
+    int offset;             /**< Estimated error, us << KALMAN_OFFSET_SHIFT */
+    int drift;              /**< Estimated rate mismatch, fractional */
+    int innovation;         /**< Last innovation, us << KALMAN_OFFSET_SHIFT */
+    unsigned history;       /**< Current length of the expanding memory */
+    unsigned memory;        /**< Steady state memory length */
+    unsigned updates;       /**< Number of updates since init */
+} ttp_kalman;
+
+/**
+ * \brief  Initialise the estimator, forgetting offset and drift.
+ *
+ * \param  kalman   estimator state
+ * \param  memory   number of updates to average over in steady state
+ */
+extern void ttp_kalman_init(ttp_kalman *kalman, unsigned memory);
+
+/**
+ * \brief  Restart the estimator after a stream restart, keeping the drift.
+ *
+ * \param  kalman   estimator state
+ */
+extern void ttp_kalman_restart(ttp_kalman *kalman);
+
+/**
+ * \brief  Update the estimator with a new latency error measurement
+ *
+ * \param  kalman   estimator state
+ * \param  raw_error   measured latency error, in us
+ * \param  dt   time since the previous measurement, in us
+ * \param  sp_adjust   sample period adjustment applied over dt
+ *
+ * \return new (unlimited) sample period adjustment
+ */
+extern int ttp_kalman_update(ttp_kalman *kalman, TIME_INTERVAL raw_error, TIME_INTERVAL dt, int sp_adjust);
+
+/**
+ * \brief  Copy the estimator state out
+ *
+ * \param  kalman   estimator state
+ * \param  state   structure to populate, type is left unchanged
+ */
+extern void ttp_kalman_get_state(const ttp_kalman *kalman, ttp_estimator_state *state);
+
 /**
  * Macro used to enable/disable the static debug logging.
  */
@@ -0,0 +1,68 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file audio_log_bench.c
+ * \ingroup AUDIO_LOG
+ *
+ * Host benchmark of the cost of one soft audio log call, in the text and the
+ * binary (AUDIO_LOG_SOFT_BINARY) variants.
+ *
+ * Build it twice against components/audio_log/audio_log_soft.c in the
+ * desktop test environment, with INSTALL_AUDIO_LOG and DESKTOP_TEST_BUILD,
+ * once with AUDIO_LOG_SOFT_BINARY defined, and run both. The text variant's
+ * output goes to /dev/null, so the terminal isn't part of the cost.
+ *
+ * Usage: audio_log_bench [calls]
+ */
+
+#include "audio_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() __rdtsc()
+#else
+#define BENCH_CYCLES() 0ULL
+#endif
+
+AUDIO_LOG_STRING(bench_name, "bench");
+
+int main(int argc, char *argv[])
+{
+    unsigned calls = (argc > 1) ? (unsigned)atoi(argv[1]) : 1000000;
+    struct timespec start, end;
+    unsigned long long cycles;
+    double ns;
+    unsigned i;
+
+#if !defined(AUDIO_LOG_SOFT_BINARY)
+    FILE *out = stdout;
+    stdout = fopen("/dev/null", "w");
+#endif
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    cycles = BENCH_CYCLES();
+    for (i = 0; i < calls; i++)
+    {
+        L2_DBG_MSG3("%s: frame %u, level %d", bench_name, i, (int)(i & 0xFF) - 128);
+    }
+    cycles = BENCH_CYCLES() - cycles;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+#if !defined(AUDIO_LOG_SOFT_BINARY)
+    fclose(stdout);
+    stdout = out;
+#endif
+
+    ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    printf("%s: %u calls, %.1f ns/call, %llu cycles/call\n",
+#if defined(AUDIO_LOG_SOFT_BINARY)
+           "binary",
+#else
+           "text",
+#endif
+           calls, ns / calls, cycles / calls);
+    return 0;
+}
@@ -0,0 +1,125 @@
+############################################################################
+# CONFIDENTIAL
+#
+# Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+#
+############################################################################
+# audio_log_decode.py
+#
+# Decodes a binary audio log written by audio_log_soft_dump() (host builds
+# with AUDIO_LOG_SOFT_BINARY) back into the text the non-binary variant
+# would have printed.
+#
+# Usage: audio_log_decode.py [-t] <dump file>
+#
+#   -t  Prefix each event with the time it was logged, in seconds. The text
+#       variant doesn't print times, so by default neither does this.
+#
+
+import os
+import re
+import struct
+import sys
+
+MAGIC = b"KALOGBIN"
+DUMP_VERSION = 2
+
+# Matches a single printf conversion specification
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*|\*)(?:\.(\d*|\*))?(hh|h|ll|l|L|z|j|t)?([diouxXcspfeEgG%])")
+
+
+class DecodeError(Exception):
+    pass
+
+
+def _read(f, fmt):
+    size = struct.calcsize(fmt)
+    data = f.read(size)
+    if len(data) != size:
+        raise DecodeError("truncated record")
+    return struct.unpack(fmt, data)
+
+
+def _to_signed(value, bits=32):
+    value &= (1 << bits) - 1
+    if value & (1 << (bits - 1)):
+        value -= 1 << bits
+    return value
+
+
+def format_event(fmt, args, strings):
+    """Expand fmt with raw argument words the same way printf would."""
+    arg_iter = iter(args)
+
+    def convert(match):
+        flags, width, precision, length, conv = match.groups()
+        if conv == '%':
+            return '%'
+        raw = next(arg_iter, 0)
+        spec = '%' + flags + (width or '')
+        if precision is not None:
+            spec += '.' + precision
+        if conv == 's':
+            return (spec + 's') % strings.get(raw, "<str 0x%x>" % raw)
+        if conv == 'p':
+            return (spec + 's') % ("0x%x" % raw)
+        if conv == 'c':
+            return (spec + 'c') % chr(raw & 0xff)
+        if conv in 'di':
+            bits = 64 if length in ('l', 'll', 'z', 'j', 't') else 32
+            return (spec + 'd') % _to_signed(raw, bits)
+        if conv in 'ouxX':
+            bits = 64 if length in ('l', 'll', 'z', 'j', 't') else 32
+            return (spec + conv) % (raw & ((1 << bits) - 1))
+        # Floating point isn't supported by the log macros
+        return "<0x%x>" % raw
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(f, out, show_time=False):
+    if f.read(len(MAGIC)) != MAGIC:
+        raise DecodeError("not an audio log dump")
+    version, elem_size = _read(f, "<HH")
+    if version != DUMP_VERSION:
+        raise DecodeError("unsupported dump version %d" % version)
+
+    strings = {}
+    while True:
+        tag = f.read(1)
+        if not tag:
+            break
+        if tag == b'S':
+            key, length = _read(f, "<QI")
+            strings[key] = f.read(length).decode("latin-1")
+        elif tag == b'L':
+            lost, = _read(f, "<I")
+            out.write("*** %d log records lost ***\n" % lost)
+        elif tag == b'E':
+            time_us, = _read(f, "<Q")
+            fmt_key, file_key, line, n_args = _read(f, "<QQIB")
+            args = _read(f, "<%dQ" % n_args) if n_args else ()
+            fmt = strings.get(fmt_key, "<fmt 0x%x>" % fmt_key)
+            module = os.path.basename(strings.get(file_key, "?"))
+            if show_time:
+                out.write("%d.%06d, " % (time_us // 1000000, time_us % 1000000))
+            out.write("%s(%u):%s\n" %
+                      (module, line, format_event(fmt, args, strings)))
+        else:
+            raise DecodeError("bad record tag %r" % tag)
+
+
+if __name__ == '__main__':
+    args = sys.argv[1:]
+    show_time = bool(args) and args[0] == "-t"
+    if show_time:
+        args = args[1:]
+    if len(args) < 1:
+        sys.stderr.write(sys.argv[0] + ": Error, Please provide a dump file\n")
+        sys.exit(1)
+    with open(args[0], "rb") as dump:
+        try:
+            decode(dump, sys.stdout, show_time)
+        except DecodeError as e:
+            sys.stderr.write(sys.argv[0] + ": Error, " + str(e) + "\n")
+            sys.exit(1)
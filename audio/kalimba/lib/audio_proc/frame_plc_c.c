@@ -0,0 +1,607 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/****************************************************************************
+Include Files
+*/
+#include "frame_plc_c.h"
+#include "pmalloc/pmalloc.h"
+#include "string.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** Samples at 8kHz of: shortest and longest pitch period, pitch search
+ *  window, LPC analysis window, cross fade, hold and fade */
+#define FRAME_PLC_MIN_PITCH_8K      20
+#define FRAME_PLC_MAX_PITCH_8K      120
+#define FRAME_PLC_PITCH_WIN_8K      80
+#define FRAME_PLC_LPC_WIN_8K        160
+#define FRAME_PLC_OLA_8K            16
+#define FRAME_PLC_HOLD_8K           80
+#define FRAME_PLC_FADE_8K           400
+
+/** LPC order for narrowband and wideband */
+#define FRAME_PLC_ORDER_NB          10
+#define FRAME_PLC_ORDER_WB          16
+
+/** Largest sample in the analysis once normalised */
+#define FRAME_PLC_NORM_BITS         14
+
+/** Right shift keeping headroom in the LPC filters */
+#define FRAME_PLC_HEADROOM          4
+
+/** Bits of the LPC coefficients after the binary point */
+#define FRAME_PLC_LPC_Q             27
+
+/** Bandwidth expansion of the LPC filter per order, Q15 */
+#define FRAME_PLC_GAMMA             32440       /* 0.99 */
+
+/** Voicing, as squared normalised correlation in Q15, below which the LPC
+ *  excitation is all noise and above which it is all residual */
+#define FRAME_PLC_UNVOICED          3277        /* 0.1 */
+#define FRAME_PLC_VOICED            16384       /* 0.5 */
+
+/** sqrt(3), Q15, the ratio of the peak to the RMS of uniform noise */
+#define FRAME_PLC_SQRT3             56756
+
+/** Packet error rate estimate moves 1/2^FRAME_PLC_PER_SHIFT of the way to
+ *  each frame's outcome */
+#define FRAME_PLC_PER_SHIFT         5
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+static inline int32 frame_plc_sat(int64 x)
+{
+    if (x > 0x7FFFFFFF)
+    {
+        return 0x7FFFFFFF;
+    }
+    if (x < -0x7FFFFFFF - 1)
+    {
+        return -0x7FFFFFFF - 1;
+    }
+    return (int32)x;
+}
+
+/**
+ * \brief Shift a sample right, or left for a negative shift.
+ */
+static inline int32 frame_plc_norm(int32 x, int shift)
+{
+    return (shift >= 0) ? (x >> shift) : (int32)((uint32)x << -shift);
+}
+
+/**
+ * \brief Integer square root.
+ */
+static uint32 frame_plc_sqrt(uint64 x)
+{
+    uint64 root = 0;
+    uint64 bit = (uint64)1 << 62;
+
+    while (bit > x)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (x >= root + bit)
+        {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32)root;
+}
+
+/**
+ * \brief Shift bringing the largest of a run of samples below
+ *        2^FRAME_PLC_NORM_BITS.
+ */
+static int frame_plc_norm_shift(const int32 *x, unsigned len)
+{
+    uint32 peak = 0;
+    int bits = 0;
+    unsigned n;
+
+    for (n = 0; n < len; n++)
+    {
+        peak |= (x[n] < 0) ? (uint32)(-(x[n] + 1)) : (uint32)x[n];
+    }
+    while ((peak >> bits) != 0)
+    {
+        bits++;
+    }
+    return (bits == 0) ? 0 : bits - FRAME_PLC_NORM_BITS;
+}
+
+/**
+ * \brief Find the pitch period at the end of the history, and how voiced
+ *        the speech is.
+ *
+ * The lag with the largest normalised correlation over the last
+ * FRAME_PLC_PITCH_WIN_8K samples is found on every other lag and sample,
+ * then refined around the best one.
+ *
+ * \param plc The instance
+ * \param shift Normalising shift of the history
+ * \param voicing Set to the squared normalised correlation at the pitch
+ *        period, Q15
+ *
+ * \return The pitch period
+ */
+static unsigned frame_plc_find_pitch(frame_plc *plc, int shift, int32 *voicing)
+{
+    const int32 *x = plc->history;
+    unsigned end = plc->history_len;
+    unsigned win = plc->max_pitch * FRAME_PLC_PITCH_WIN_8K / FRAME_PLC_MAX_PITCH_8K;
+    unsigned best_lag = plc->max_pitch;
+    int64 best_score = 0;
+    int64 best_c = 0, best_e = 1, e0 = 0;
+    unsigned lag, lo, hi, step, n;
+
+    for (n = end - win; n < end; n++)
+    {
+        int32 s = frame_plc_norm(x[n], shift);
+
+        e0 += (int64)s * s;
+    }
+
+    /* Every other lag and sample, then every lag and sample around the
+     * best of those */
+    lo = plc->min_pitch;
+    hi = plc->max_pitch;
+    for (step = 2; step != 0; step--)
+    {
+        best_score = 0;
+        for (lag = lo; lag <= hi; lag += step)
+        {
+            int64 c = 0, e = 0, score = 0;
+
+            for (n = end - win; n < end; n += step)
+            {
+                int32 s = frame_plc_norm(x[n], shift);
+                int32 d = frame_plc_norm(x[n - lag], shift);
+
+                c += (int64)s * d;
+                e += (int64)d * d;
+            }
+            if (c > 0)
+            {
+                int64 ch = c >> 8;
+
+                score = (ch * ch) / ((e >> 16) + 1);
+            }
+            if (score > best_score)
+            {
+                best_score = score;
+                best_lag = lag;
+                best_c = c * step;
+                best_e = e * step;
+            }
+        }
+        lo = (best_lag > plc->min_pitch) ? best_lag - 1 : best_lag;
+        hi = (best_lag < plc->max_pitch) ? best_lag + 1 : best_lag;
+    }
+
+    *voicing = 0;
+    if (best_c > 0 && e0 > 0)
+    {
+        int64 ch = best_c >> 8;
+        int64 v = (((ch * ch) / ((best_e >> 16) + 1)) << 15) / ((e0 >> 16) + 1);
+
+        *voicing = (v > 32767) ? 32767 : (int32)v;
+    }
+    return best_lag;
+}
+
+/**
+ * \brief Set up pitch repetition: the last period, with its end cross
+ *        faded into the period before so that it repeats smoothly.
+ */
+static void frame_plc_start_pitch(frame_plc *plc)
+{
+    const int32 *x = plc->history;
+    unsigned end = plc->history_len;
+    unsigned p = plc->pitch;
+    unsigned q = p >> 2;
+    unsigned k;
+
+    memcpy(plc->period, x + end - p, p * sizeof(int32));
+    for (k = 0; k < q; k++)
+    {
+        int32 w = (int32)(((k + 1) << 15) / (q + 1));
+
+        plc->period[p - q + k] = (int32)(((int64)x[end - q + k] * (32768 - w) +
+                                          (int64)x[end - p - q + k] * w) >> 15);
+    }
+}
+
+/**
+ * \brief Set up LPC concealment: fit the filter to the last samples, find
+ *        the residual of the last pitch period and the noise level, and
+ *        load the filter state.
+ */
+static void frame_plc_start_lpc(frame_plc *plc, int shift)
+{
+    const int32 *x = plc->history;
+    unsigned end = plc->history_len;
+    unsigned order = plc->order;
+    unsigned win = plc->max_pitch * FRAME_PLC_LPC_WIN_8K / FRAME_PLC_MAX_PITCH_8K;
+    int64 r64[FRAME_PLC_MAX_ORDER + 1];
+    int32 r[FRAME_PLC_MAX_ORDER + 1];
+    int32 a[FRAME_PLC_MAX_ORDER];
+    int32 prev[FRAME_PLC_MAX_ORDER];
+    int64 err;
+    uint64 energy = 0;
+    int32 gamma;
+    unsigned i, j, n;
+    int rs = 0;
+
+    /* Autocorrelation of the analysis window */
+    for (i = 0; i <= order; i++)
+    {
+        int64 acc = 0;
+
+        for (n = end - win + i; n < end; n++)
+        {
+            acc += (int64)frame_plc_norm(x[n], shift) * frame_plc_norm(x[n - i], shift);
+        }
+        r64[i] = acc;
+    }
+
+    memset(a, 0, sizeof(a));
+    if (r64[0] > 0)
+    {
+        while ((r64[0] >> rs) >= ((int64)1 << 30))
+        {
+            rs++;
+        }
+        for (i = 0; i <= order; i++)
+        {
+            r[i] = (int32)(r64[i] >> rs);
+        }
+        /* White noise correction, -40dB */
+        r[0] += r[0] >> 13;
+
+        /* Levinson-Durbin recursion */
+        err = r[0];
+        for (i = 0; i < order; i++)
+        {
+            int64 acc = (int64)r[i + 1] << FRAME_PLC_LPC_Q;
+            int64 k;
+
+            for (j = 0; j < i; j++)
+            {
+                acc += (int64)a[j] * r[i - j];
+            }
+            k = -acc / err;
+            if (k >= ((int64)1 << FRAME_PLC_LPC_Q) || k <= -((int64)1 << FRAME_PLC_LPC_Q))
+            {
+                break;
+            }
+            memcpy(prev, a, i * sizeof(int32));
+            for (j = 0; j < i; j++)
+            {
+                a[j] = prev[j] + (int32)((k * prev[i - 1 - j]) >> FRAME_PLC_LPC_Q);
+            }
+            a[i] = (int32)k;
+            err -= (err * ((k * k) >> FRAME_PLC_LPC_Q)) >> FRAME_PLC_LPC_Q;
+            if (err <= 0)
+            {
+                break;
+            }
+        }
+    }
+
+    /* Bandwidth expansion keeps the synthesis filter well damped */
+    gamma = FRAME_PLC_GAMMA;
+    for (i = 0; i < order; i++)
+    {
+        plc->lpc[i] = (int32)(((int64)a[i] * gamma) >> 15);
+        gamma = (int32)(((int64)gamma * FRAME_PLC_GAMMA) >> 15);
+    }
+
+    /* Residual of the last pitch period */
+    for (n = 0; n < plc->pitch; n++)
+    {
+        unsigned t = end - plc->pitch + n;
+        int64 acc = (int64)(x[t] >> FRAME_PLC_HEADROOM) << FRAME_PLC_LPC_Q;
+        int32 e;
+
+        for (j = 0; j < order; j++)
+        {
+            acc += (int64)plc->lpc[j] * (x[t - 1 - j] >> FRAME_PLC_HEADROOM);
+        }
+        e = frame_plc_sat(acc >> FRAME_PLC_LPC_Q);
+        plc->period[n] = e;
+        energy += (uint64)((int64)(e >> 8) * (e >> 8));
+    }
+    plc->noise_rms = (int32)(((int64)frame_plc_sqrt(energy / plc->pitch) << 8) *
+                             FRAME_PLC_SQRT3 >> 15);
+
+    /* Filter state is the end of the history */
+    for (j = 0; j < order; j++)
+    {
+        plc->synth[j] = x[end - order + j] >> FRAME_PLC_HEADROOM;
+    }
+}
+
+/**
+ * \brief Start concealing a loss: choose the way, find the pitch and set
+ *        up the chosen way.
+ */
+static void frame_plc_start_loss(frame_plc *plc)
+{
+    int shift = frame_plc_norm_shift(plc->history, plc->history_len);
+    int32 voicing;
+
+    plc->active_mode = plc->mode;
+    if (plc->active_mode == FRAME_PLC_MODE_AUTO)
+    {
+        plc->active_mode = (plc->per > plc->per_threshold) ? FRAME_PLC_MODE_PITCH : FRAME_PLC_MODE_LPC;
+    }
+
+    plc->pitch = frame_plc_find_pitch(plc, shift, &voicing);
+    plc->phase = 0;
+    plc->concealed = 0;
+    plc->gain = 0x7FFFFFFF;
+
+    if (plc->active_mode == FRAME_PLC_MODE_PITCH)
+    {
+        frame_plc_start_pitch(plc);
+    }
+    else
+    {
+        if (voicing >= FRAME_PLC_VOICED)
+        {
+            plc->voicing = 32767;
+        }
+        else if (voicing <= FRAME_PLC_UNVOICED)
+        {
+            plc->voicing = 0;
+        }
+        else
+        {
+            plc->voicing = (voicing - FRAME_PLC_UNVOICED) * 32767 / (FRAME_PLC_VOICED - FRAME_PLC_UNVOICED);
+        }
+        frame_plc_start_lpc(plc, shift);
+    }
+}
+
+/**
+ * \brief Make up samples of the loss being concealed.
+ */
+static void frame_plc_generate(frame_plc *plc, int32 *out, unsigned len)
+{
+    unsigned order = plc->order;
+    int32 *y = plc->synth + order;
+    unsigned n, j;
+
+    for (n = 0; n < len; n++)
+    {
+        int32 s;
+
+        if (plc->gain == 0)
+        {
+            out[n] = 0;
+            continue;
+        }
+
+        if (plc->active_mode == FRAME_PLC_MODE_PITCH)
+        {
+            s = plc->period[plc->phase];
+        }
+        else
+        {
+            int32 noise, exc;
+            int64 acc;
+
+            plc->seed = plc->seed * 1664525u + 1013904223u;
+            noise = (int32)(((int64)(int32)plc->seed * plc->noise_rms) >> 31);
+            exc = (int32)(((int64)plc->period[plc->phase] * plc->voicing +
+                           (int64)noise * (32767 - plc->voicing)) >> 15);
+
+            acc = (int64)exc << FRAME_PLC_LPC_Q;
+            for (j = 0; j < order; j++)
+            {
+                acc -= (int64)plc->lpc[j] * y[(int)n - 1 - (int)j];
+            }
+            acc >>= FRAME_PLC_LPC_Q;
+            /* Keep the headroom the filter state was loaded with */
+            if (acc > (0x7FFFFFFF >> FRAME_PLC_HEADROOM))
+            {
+                acc = 0x7FFFFFFF >> FRAME_PLC_HEADROOM;
+            }
+            else if (acc < -(0x7FFFFFFF >> FRAME_PLC_HEADROOM))
+            {
+                acc = -(0x7FFFFFFF >> FRAME_PLC_HEADROOM);
+            }
+            y[n] = (int32)acc;
+            s = (int32)acc << FRAME_PLC_HEADROOM;
+        }
+
+        out[n] = (int32)(((int64)s * plc->gain) >> 31);
+
+        if (++plc->phase >= plc->pitch)
+        {
+            plc->phase = 0;
+        }
+        if (++plc->concealed > plc->hold_len)
+        {
+            plc->gain = (plc->gain > plc->fade_step) ? plc->gain - plc->fade_step : 0;
+        }
+    }
+
+    if (plc->active_mode == FRAME_PLC_MODE_LPC && len != 0)
+    {
+        /* The last samples made are the filter state for the next ones */
+        if (plc->gain == 0)
+        {
+            memset(plc->synth, 0, order * sizeof(int32));
+        }
+        else
+        {
+            memmove(plc->synth, plc->synth + len, order * sizeof(int32));
+        }
+    }
+}
+
+/**
+ * \brief Add a frame to the end of the history.
+ */
+static void frame_plc_push(frame_plc *plc, const int32 *frame, unsigned len)
+{
+    unsigned keep = plc->history_len - len;
+
+    memmove(plc->history, plc->history + len, keep * sizeof(int32));
+    memcpy(plc->history + keep, frame, len * sizeof(int32));
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/*
+ * frame_plc_create
+ */
+frame_plc *frame_plc_create(unsigned frame_len, unsigned sample_rate)
+{
+    frame_plc *plc;
+    unsigned scale;
+
+    if (frame_len == 0 || frame_len > FRAME_PLC_MAX_FRAME ||
+        (sample_rate != 8000 && sample_rate != 16000))
+    {
+        return NULL;
+    }
+    scale = sample_rate / 8000;
+
+    plc = xzpnew(frame_plc);
+    if (plc == NULL)
+    {
+        return NULL;
+    }
+    plc->frame_len = frame_len;
+    plc->min_pitch = FRAME_PLC_MIN_PITCH_8K * scale;
+    plc->max_pitch = FRAME_PLC_MAX_PITCH_8K * scale;
+    plc->order = (scale == 1) ? FRAME_PLC_ORDER_NB : FRAME_PLC_ORDER_WB;
+    plc->ola_len = FRAME_PLC_OLA_8K * scale;
+    plc->hold_len = FRAME_PLC_HOLD_8K * scale;
+    plc->fade_step = 0x7FFFFFFF / (FRAME_PLC_FADE_8K * scale);
+    plc->mode = FRAME_PLC_MODE_AUTO;
+    plc->per_threshold = FRAME_PLC_DEFAULT_PER_THRESHOLD;
+
+    /* Enough for the pitch search and the LPC analysis, and a frame */
+    plc->history_len = (FRAME_PLC_MAX_PITCH_8K + FRAME_PLC_PITCH_WIN_8K) * scale;
+    if (plc->history_len < frame_len)
+    {
+        plc->history_len = frame_len;
+    }
+
+    plc->history = xzpnewn(plc->history_len, int32);
+    plc->period = xzpnewn(plc->max_pitch, int32);
+    plc->synth = xzpnewn(plc->order + ((frame_len > plc->ola_len) ? frame_len : plc->ola_len), int32);
+    if (plc->history == NULL || plc->period == NULL || plc->synth == NULL)
+    {
+        frame_plc_destroy(plc);
+        return NULL;
+    }
+    frame_plc_reset(plc);
+    return plc;
+}
+
+/*
+ * frame_plc_destroy
+ */
+void frame_plc_destroy(frame_plc *plc)
+{
+    if (plc != NULL)
+    {
+        pfree(plc->history);
+        pfree(plc->period);
+        pfree(plc->synth);
+        pfree(plc);
+    }
+}
+
+/*
+ * frame_plc_reset
+ */
+void frame_plc_reset(frame_plc *plc)
+{
+    memset(plc->history, 0, plc->history_len * sizeof(int32));
+    plc->per = 0;
+    plc->lost_frames = 0;
+    plc->seed = 1;
+}
+
+/*
+ * frame_plc_set_mode
+ */
+void frame_plc_set_mode(frame_plc *plc, frame_plc_mode mode, unsigned per_threshold)
+{
+    plc->mode = mode;
+    plc->per_threshold = per_threshold;
+}
+
+/*
+ * frame_plc_get_per
+ */
+unsigned frame_plc_get_per(const frame_plc *plc)
+{
+    return plc->per;
+}
+
+/*
+ * frame_plc_good_frame
+ */
+void frame_plc_good_frame(frame_plc *plc, int32 *frame, unsigned len)
+{
+    plc->per -= plc->per >> FRAME_PLC_PER_SHIFT;
+
+    if (plc->lost_frames != 0)
+    {
+        int32 tail[FRAME_PLC_OLA_8K * 2];
+        unsigned ola_len = (plc->ola_len < len) ? plc->ola_len : len;
+        unsigned k;
+
+        /* Fade from the concealed speech into the received speech */
+        frame_plc_generate(plc, tail, ola_len);
+        for (k = 0; k < ola_len; k++)
+        {
+            int32 w = (int32)(((k + 1) << 15) / (ola_len + 1));
+
+            frame[k] = (int32)(((int64)tail[k] * (32768 - w) + (int64)frame[k] * w) >> 15);
+        }
+        plc->lost_frames = 0;
+    }
+
+    frame_plc_push(plc, frame, len);
+}
+
+/*
+ * frame_plc_conceal
+ */
+void frame_plc_conceal(frame_plc *plc, int32 *frame, unsigned len)
+{
+    plc->per += (32768 - plc->per) >> FRAME_PLC_PER_SHIFT;
+
+    if (plc->lost_frames == 0)
+    {
+        frame_plc_start_loss(plc);
+    }
+    frame_plc_generate(plc, frame, len);
+    plc->lost_frames++;
+
+    frame_plc_push(plc, frame, len);
+}
@@ -0,0 +1,190 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file frame_plc_c.h
+ * \ingroup audio_proc
+ *
+ * Frame based packet loss concealment. <br>
+ *
+ * Every frame of a speech stream is either received, and passed in to be
+ * remembered, or lost, and made up from what was received before. A lost
+ * frame is made up in one of two ways:
+ *  - pitch repetition, which repeats the last pitch period received. It
+ *    costs little more than a copy once the pitch is found.
+ *  - LPC, which drives a linear prediction filter fitted to the last
+ *    frames with the last pitch period of its residual, mixed with noise
+ *    as the speech was unvoiced. It follows the spectrum of the speech
+ *    more closely, and does not buzz on unvoiced sounds, for a few times
+ *    the cycles.
+ * The way is chosen at the start of each loss, from an estimate of the
+ * packet error rate: LPC while losses are rare, pitch repetition once they
+ * are common enough that their cost adds up. Either can also be forced.
+ *
+ * Concealed speech is held for 10ms, then faded out over the next 50ms.
+ * The first frame received after a loss is cross faded from the concealed
+ * speech.
+ */
+
+#ifndef _FRAME_PLC_C_H_
+#define _FRAME_PLC_C_H_
+/****************************************************************************
+Include Files
+*/
+
+#include "types.h"
+
+/****************************************************************************
+Public Constant Declarations
+*/
+
+/** Longest frame, in samples */
+#define FRAME_PLC_MAX_FRAME         240
+
+/** Highest order of the LPC filter */
+#define FRAME_PLC_MAX_ORDER         16
+
+/** Default packet error rate above which pitch repetition is used, Q15 */
+#define FRAME_PLC_DEFAULT_PER_THRESHOLD     3277    /* 0.1 */
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/** Ways of concealing a loss */
+typedef enum
+{
+    /** Chosen from the packet error rate at the start of each loss */
+    FRAME_PLC_MODE_AUTO,
+    /** Always repeat the last pitch period */
+    FRAME_PLC_MODE_PITCH,
+    /** Always use the LPC filter */
+    FRAME_PLC_MODE_LPC
+} frame_plc_mode;
+
+/** Packet loss concealment instance */
+typedef struct frame_plc
+{
+    /** Longest frame, in samples */
+    unsigned frame_len;
+    /** Shortest and longest pitch periods searched, in samples */
+    unsigned min_pitch;
+    unsigned max_pitch;
+    /** Order of the LPC filter */
+    unsigned order;
+    /** Samples cross faded at the end of a loss */
+    unsigned ola_len;
+    /** Samples held at full level at the start of a loss */
+    unsigned hold_len;
+    /** Fall of the level per sample once the hold ends, Q31 */
+    int32 fade_step;
+
+    /** Requested way of concealing */
+    frame_plc_mode mode;
+    /** Packet error rate above which AUTO repeats the pitch, Q15 */
+    unsigned per_threshold;
+    /** Estimated packet error rate, Q15 */
+    unsigned per;
+
+    /** Last samples output, the oldest first */
+    int32 *history;
+    /** Number of samples in history */
+    unsigned history_len;
+
+    /** Frames concealed since the last one received */
+    unsigned lost_frames;
+    /** Way the current loss is concealed, PITCH or LPC */
+    frame_plc_mode active_mode;
+    /** Pitch period of the current loss, in samples */
+    unsigned pitch;
+    /** Position in the repeated period */
+    unsigned phase;
+    /** Samples concealed in the current loss */
+    unsigned concealed;
+    /** Level of the concealed speech, Q31 */
+    int32 gain;
+
+    /** Repeated period: speech for PITCH, LPC residual for LPC */
+    int32 *period;
+    /** LPC coefficients, Q27, of z^-1 onwards */
+    int32 lpc[FRAME_PLC_MAX_ORDER];
+    /** Share of the residual in the LPC excitation, the rest noise, Q15 */
+    int32 voicing;
+    /** Peak of the uniform noise in the LPC excitation, which gives it the
+     *  RMS of the residual */
+    int32 noise_rms;
+    /** Noise generator state */
+    uint32 seed;
+    /** LPC synthesis work buffer: order samples of filter state followed
+     *  by the samples being made */
+    int32 *synth;
+} frame_plc;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief Create a concealment instance, in AUTO mode.
+ *
+ * \param frame_len Samples in the longest frame that will be passed in, up
+ *        to FRAME_PLC_MAX_FRAME
+ * \param sample_rate Sample rate, 8000 or 16000
+ *
+ * \return Pointer to the new instance, NULL if creation failed
+ */
+extern frame_plc *frame_plc_create(unsigned frame_len, unsigned sample_rate);
+
+/**
+ * \brief Destroy a concealment instance.
+ *
+ * \param plc The instance to destroy, may be NULL
+ */
+extern void frame_plc_destroy(frame_plc *plc);
+
+/**
+ * \brief Forget the speech so far, as at the start of a call.
+ *
+ * \param plc The instance
+ */
+extern void frame_plc_reset(frame_plc *plc);
+
+/**
+ * \brief Choose how losses are concealed. Applies from the next loss.
+ *
+ * \param plc The instance
+ * \param mode The way to conceal
+ * \param per_threshold Packet error rate above which AUTO repeats the
+ *        pitch, Q15
+ */
+extern void frame_plc_set_mode(frame_plc *plc, frame_plc_mode mode, unsigned per_threshold);
+
+/**
+ * \brief Get the estimated packet error rate.
+ *
+ * \param plc The instance
+ *
+ * \return Packet error rate, Q15
+ */
+extern unsigned frame_plc_get_per(const frame_plc *plc);
+
+/**
+ * \brief Pass in a received frame. After a loss its start is cross faded
+ *        from the concealed speech, in place.
+ *
+ * \param plc The instance
+ * \param frame The received samples
+ * \param len Samples in the frame, up to the frame_len it was created with
+ */
+extern void frame_plc_good_frame(frame_plc *plc, int32 *frame, unsigned len);
+
+/**
+ * \brief Make up a lost frame.
+ *
+ * \param plc The instance
+ * \param frame Where to write the samples
+ * \param len Samples in the frame, up to the frame_len it was created with
+ */
+extern void frame_plc_conceal(frame_plc *plc, int32 *frame, unsigned len);
+
+#endif /* _FRAME_PLC_C_H_ */
@@ -0,0 +1,566 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/****************************************************************************
+Include Files
+*/
+#include "fft_c.h"
+#include "pmalloc/pmalloc.h"
+#include "string.h"
+
+/****************************************************************************
+Private Constant Declarations
+*/
+
+/** 1.0 in Q30, the format of the twiddle series */
+#define FFT_C_ONE_Q30           ((int32)1 << 30)
+
+/** pi/2 in Q31 */
+#define FFT_C_HALF_PI_Q31       3373259426u
+
+/** 1/3 and 1/5 in Q31, the per-stage scaling of the inverse transform */
+#define FFT_C_THIRD_Q31         715827883
+#define FFT_C_FIFTH_Q31         429496730
+
+/** sin(2*pi/3), Q31 */
+#define FFT_C_SIN_60_Q31        1859775393
+
+/** cos and sin of 2*pi/5 and 4*pi/5, Q31 */
+#define FFT_C_COS_72_Q31        663608941
+#define FFT_C_COS_144_Q31       (-1737350766)
+#define FFT_C_SIN_72_Q31        2042378317
+#define FFT_C_SIN_144_Q31       1262259218
+
+/** Largest radix */
+#define FFT_C_MAX_RADIX         5
+
+/****************************************************************************
+Private Macro Declarations
+*/
+
+/** Q31 fractional multiply, rounded */
+#define FFT_C_MULT(a, b)    ((int32)(((int64)(a) * (b) + (1 << 30)) >> 31))
+
+/****************************************************************************
+Private Function Definitions
+*/
+
+/**
+ * \brief sin and cos of an angle from 0 to pi/4, by their Taylor series.
+ *
+ * \param x The angle in radians, Q31
+ * \param sin_val Receives sin(x), Q31
+ * \param cos_val Receives cos(x), Q31, saturated at 1.0
+ */
+static void fft_c_sin_cos(int32 x, int32 *sin_val, int32 *cos_val)
+{
+    static const int32 sin_div[] = {110, 72, 42, 20, 6};
+    static const int32 cos_div[] = {132, 90, 56, 30, 12, 2};
+    int32 x2 = (int32)(((int64)x * x) >> 31);
+    int32 t;
+    int64 c;
+    unsigned i;
+
+    /* Horner's rule, with the partial sums in Q30 as they reach 1.0 */
+    t = FFT_C_ONE_Q30;
+    for (i = 0; i < sizeof(sin_div) / sizeof(sin_div[0]); i++)
+    {
+        t = FFT_C_ONE_Q30 - (int32)((((int64)t * x2) >> 31) / sin_div[i]);
+    }
+    *sin_val = (int32)(((int64)t * x) >> 30);
+
+    t = FFT_C_ONE_Q30;
+    for (i = 0; i < sizeof(cos_div) / sizeof(cos_div[0]); i++)
+    {
+        t = FFT_C_ONE_Q30 - (int32)((((int64)t * x2) >> 31) / cos_div[i]);
+    }
+    c = (int64)t << 1;
+    *cos_val = (c > 0x7FFFFFFF) ? 0x7FFFFFFF : (int32)c;
+}
+
+/**
+ * \brief Split a length into stages, radix-4 first.
+ *
+ * \return TRUE if the length factors into 2, 3 and 5
+ */
+static bool fft_c_factorise(fft_c_plan *plan)
+{
+    static const unsigned radices[] = {4, 2, 3, 5};
+    unsigned n = plan->num_points;
+    unsigned i;
+
+    plan->num_stages = 0;
+    for (i = 0; i < sizeof(radices) / sizeof(radices[0]); i++)
+    {
+        while (n % radices[i] == 0)
+        {
+            if (plan->num_stages == FFT_C_MAX_STAGES)
+            {
+                return FALSE;
+            }
+            plan->radix[plan->num_stages++] = radices[i];
+            n /= radices[i];
+        }
+    }
+    return n == 1;
+}
+
+/**
+ * \brief Multiply a complex value in place by another.
+ */
+static void fft_c_cmul(int32 *re, int32 *im, int32 c, int32 s)
+{
+    int64 a = *re, b = *im;
+
+    *re = (int32)((a * c - b * s + (1 << 30)) >> 31);
+    *im = (int32)((a * s + b * c + (1 << 30)) >> 31);
+}
+
+/**
+ * \brief Radix-2 butterfly.
+ */
+static void fft_c_butterfly_2(int32 *re, int32 *im)
+{
+    int32 t;
+
+    t = re[1]; re[1] = re[0] - t; re[0] += t;
+    t = im[1]; im[1] = im[0] - t; im[0] += t;
+}
+
+/**
+ * \brief Radix-4 butterfly.
+ */
+static void fft_c_butterfly_4(int32 *re, int32 *im)
+{
+    int32 t0r = re[0] + re[2], t0i = im[0] + im[2];
+    int32 t1r = re[0] - re[2], t1i = im[0] - im[2];
+    int32 t2r = re[1] + re[3], t2i = im[1] + im[3];
+    int32 t3r = re[1] - re[3], t3i = im[1] - im[3];
+
+    re[0] = t0r + t2r; im[0] = t0i + t2i;
+    re[2] = t0r - t2r; im[2] = t0i - t2i;
+    /* X1 = t1 - i*t3, X3 = t1 + i*t3 */
+    re[1] = t1r + t3i; im[1] = t1i - t3r;
+    re[3] = t1r - t3i; im[3] = t1i + t3r;
+}
+
+/**
+ * \brief Radix-3 butterfly.
+ */
+static void fft_c_butterfly_3(int32 *re, int32 *im)
+{
+    int32 t1r = re[1] + re[2], t1i = im[1] + im[2];
+    int32 t2r = re[0] - (t1r >> 1), t2i = im[0] - (t1i >> 1);
+    int32 t3r = FFT_C_MULT(re[1] - re[2], FFT_C_SIN_60_Q31);
+    int32 t3i = FFT_C_MULT(im[1] - im[2], FFT_C_SIN_60_Q31);
+
+    re[0] += t1r; im[0] += t1i;
+    /* X1 = t2 - i*t3, X2 = t2 + i*t3 */
+    re[1] = t2r + t3i; im[1] = t2i - t3r;
+    re[2] = t2r - t3i; im[2] = t2i + t3r;
+}
+
+/**
+ * \brief Radix-5 butterfly.
+ */
+static void fft_c_butterfly_5(int32 *re, int32 *im)
+{
+    int32 a1r = re[1] + re[4], a1i = im[1] + im[4];
+    int32 a2r = re[2] + re[3], a2i = im[2] + im[3];
+    int32 b1r = re[1] - re[4], b1i = im[1] - im[4];
+    int32 b2r = re[2] - re[3], b2i = im[2] - im[3];
+    int32 m1r = re[0] + FFT_C_MULT(a1r, FFT_C_COS_72_Q31) + FFT_C_MULT(a2r, FFT_C_COS_144_Q31);
+    int32 m1i = im[0] + FFT_C_MULT(a1i, FFT_C_COS_72_Q31) + FFT_C_MULT(a2i, FFT_C_COS_144_Q31);
+    int32 m2r = re[0] + FFT_C_MULT(a1r, FFT_C_COS_144_Q31) + FFT_C_MULT(a2r, FFT_C_COS_72_Q31);
+    int32 m2i = im[0] + FFT_C_MULT(a1i, FFT_C_COS_144_Q31) + FFT_C_MULT(a2i, FFT_C_COS_72_Q31);
+    int32 n1r = FFT_C_MULT(b1r, FFT_C_SIN_72_Q31) + FFT_C_MULT(b2r, FFT_C_SIN_144_Q31);
+    int32 n1i = FFT_C_MULT(b1i, FFT_C_SIN_72_Q31) + FFT_C_MULT(b2i, FFT_C_SIN_144_Q31);
+    int32 n2r = FFT_C_MULT(b1r, FFT_C_SIN_144_Q31) - FFT_C_MULT(b2r, FFT_C_SIN_72_Q31);
+    int32 n2i = FFT_C_MULT(b1i, FFT_C_SIN_144_Q31) - FFT_C_MULT(b2i, FFT_C_SIN_72_Q31);
+
+    re[0] += a1r + a2r; im[0] += a1i + a2i;
+    /* X1 = m1 - i*n1, X4 = m1 + i*n1, X2 = m2 - i*n2, X3 = m2 + i*n2 */
+    re[1] = m1r + n1i; im[1] = m1i - n1r;
+    re[4] = m1r - n1i; im[4] = m1i + n1r;
+    re[2] = m2r + n2i; im[2] = m2i - n2r;
+    re[3] = m2r - n2i; im[3] = m2i + n2r;
+}
+
+/**
+ * \brief One Stockham stage: combine radix transforms of span points into
+ *        transforms of radix*span points, writing them in natural order.
+ *
+ * \param plan The plan
+ * \param radix Radix of the stage
+ * \param span Length of the transforms made by the previous stages
+ * \param in_re Input real parts
+ * \param in_im Input imaginary parts
+ * \param out_re Receives the output real parts
+ * \param out_im Receives the output imaginary parts
+ * \param scale Whether to divide the stage's output by radix
+ */
+static void fft_c_stage(const fft_c_plan *plan, unsigned radix, unsigned span,
+                        const int32 *in_re, const int32 *in_im,
+                        int32 *out_re, int32 *out_im, bool scale)
+{
+    unsigned stride = plan->num_points / radix;
+    unsigned groups = stride / span;
+    unsigned tw_step = groups;
+    int32 re[FFT_C_MAX_RADIX], im[FFT_C_MAX_RADIX];
+    unsigned g, k, r;
+
+    for (g = 0; g < groups; g++)
+    {
+        for (k = 0; k < span; k++)
+        {
+            unsigned j = g * span + k;
+            unsigned dst = g * span * radix + k;
+
+            for (r = 0; r < radix; r++)
+            {
+                re[r] = in_re[j + r * stride];
+                im[r] = in_im[j + r * stride];
+            }
+
+            if (scale)
+            {
+                for (r = 0; r < radix; r++)
+                {
+                    switch (radix)
+                    {
+                        case 2:
+                            re[r] >>= 1; im[r] >>= 1;
+                            break;
+                        case 4:
+                            re[r] >>= 2; im[r] >>= 2;
+                            break;
+                        case 3:
+                            re[r] = FFT_C_MULT(re[r], FFT_C_THIRD_Q31);
+                            im[r] = FFT_C_MULT(im[r], FFT_C_THIRD_Q31);
+                            break;
+                        default:
+                            re[r] = FFT_C_MULT(re[r], FFT_C_FIFTH_Q31);
+                            im[r] = FFT_C_MULT(im[r], FFT_C_FIFTH_Q31);
+                            break;
+                    }
+                }
+            }
+
+            if (k != 0)
+            {
+                for (r = 1; r < radix; r++)
+                {
+                    unsigned idx = r * k * tw_step;
+
+                    fft_c_cmul(&re[r], &im[r], plan->twiddle_real[idx], plan->twiddle_imag[idx]);
+                }
+            }
+
+            switch (radix)
+            {
+                case 2:
+                    fft_c_butterfly_2(re, im);
+                    break;
+                case 4:
+                    fft_c_butterfly_4(re, im);
+                    break;
+                case 3:
+                    fft_c_butterfly_3(re, im);
+                    break;
+                default:
+                    fft_c_butterfly_5(re, im);
+                    break;
+            }
+
+            for (r = 0; r < radix; r++)
+            {
+                out_re[dst + r * span] = re[r];
+                out_im[dst + r * span] = im[r];
+            }
+        }
+    }
+}
+
+/**
+ * \brief Run all the stages of a plan, in place.
+ */
+static void fft_c_run(const fft_c_plan *plan, int32 *real, int32 *imag, bool scale)
+{
+    int32 *src_re = real, *src_im = imag;
+    int32 *dst_re = plan->work_real, *dst_im = plan->work_imag;
+    unsigned span = 1;
+    unsigned s;
+
+    for (s = 0; s < plan->num_stages; s++)
+    {
+        int32 *t;
+
+        fft_c_stage(plan, plan->radix[s], span, src_re, src_im, dst_re, dst_im, scale);
+        span *= plan->radix[s];
+
+        t = src_re; src_re = dst_re; dst_re = t;
+        t = src_im; src_im = dst_im; dst_im = t;
+    }
+
+    if (src_re != real)
+    {
+        memcpy(real, src_re, plan->num_points * sizeof(int32));
+        memcpy(imag, src_im, plan->num_points * sizeof(int32));
+    }
+}
+
+/****************************************************************************
+Public Function Definitions
+*/
+
+/*
+ * fft_c_twiddle
+ */
+void fft_c_twiddle(unsigned k, unsigned n, int32 *cos_val, int32 *sin_val)
+{
+    unsigned quadrant, rem;
+    int32 c, s;
+
+    /* 4k/n = quadrant + rem/n */
+    k %= n;
+    quadrant = (4 * k) / n;
+    rem = 4 * k - quadrant * n;
+
+    /* Reduce the angle within the quadrant to at most pi/4 */
+    if (2 * rem <= n)
+    {
+        fft_c_sin_cos((int32)(((uint64)rem * FFT_C_HALF_PI_Q31) / n), &s, &c);
+    }
+    else
+    {
+        fft_c_sin_cos((int32)(((uint64)(n - rem) * FFT_C_HALF_PI_Q31) / n), &c, &s);
+    }
+
+    switch (quadrant)
+    {
+        case 0:
+            *cos_val = c; *sin_val = s;
+            break;
+        case 1:
+            *cos_val = -s; *sin_val = c;
+            break;
+        case 2:
+            *cos_val = -c; *sin_val = -s;
+            break;
+        default:
+            *cos_val = s; *sin_val = -c;
+            break;
+    }
+}
+
+/*
+ * fft_c_create
+ */
+fft_c_plan *fft_c_create(unsigned num_points)
+{
+    fft_c_plan *plan;
+    unsigned k;
+
+    if (num_points < FFT_C_MIN_POINTS || num_points > FFT_C_MAX_POINTS)
+    {
+        return NULL;
+    }
+
+    plan = xzpnew(fft_c_plan);
+    if (plan == NULL)
+    {
+        return NULL;
+    }
+    plan->num_points = num_points;
+    if (!fft_c_factorise(plan))
+    {
+        pfree(plan);
+        return NULL;
+    }
+
+    plan->twiddle_real = xpnewn(num_points, int32);
+    plan->twiddle_imag = xpnewn(num_points, int32);
+    plan->work_real = xpnewn(num_points, int32);
+    plan->work_imag = xpnewn(num_points, int32);
+    if (plan->twiddle_real == NULL || plan->twiddle_imag == NULL ||
+        plan->work_real == NULL || plan->work_imag == NULL)
+    {
+        fft_c_destroy(plan);
+        return NULL;
+    }
+
+    for (k = 0; k < num_points; k++)
+    {
+        int32 s;
+
+        fft_c_twiddle(k, num_points, &plan->twiddle_real[k], &s);
+        plan->twiddle_imag[k] = -s;
+    }
+    return plan;
+}
+
+/*
+ * fft_c_create_real
+ */
+fft_c_plan *fft_c_create_real(unsigned num_points)
+{
+    fft_c_plan *plan;
+    unsigned half = num_points / 2;
+    unsigned k;
+
+    if ((num_points & 1) != 0)
+    {
+        return NULL;
+    }
+
+    plan = fft_c_create(half);
+    if (plan == NULL)
+    {
+        return NULL;
+    }
+
+    plan->split_real = xpnewn(half / 2 + 1, int32);
+    plan->split_imag = xpnewn(half / 2 + 1, int32);
+    if (plan->split_real == NULL || plan->split_imag == NULL)
+    {
+        fft_c_destroy(plan);
+        return NULL;
+    }
+
+    for (k = 0; k <= half / 2; k++)
+    {
+        int32 s;
+
+        fft_c_twiddle(k, num_points, &plan->split_real[k], &s);
+        plan->split_imag[k] = -s;
+    }
+    return plan;
+}
+
+/*
+ * fft_c_destroy
+ */
+void fft_c_destroy(fft_c_plan *plan)
+{
+    if (plan != NULL)
+    {
+        pfree(plan->twiddle_real);
+        pfree(plan->twiddle_imag);
+        pfree(plan->work_real);
+        pfree(plan->work_imag);
+        pfree(plan->split_real);
+        pfree(plan->split_imag);
+        pfree(plan);
+    }
+}
+
+/*
+ * fft_c_forward
+ */
+void fft_c_forward(const fft_c_plan *plan, int32 *real, int32 *imag)
+{
+    fft_c_run(plan, real, imag, FALSE);
+}
+
+/*
+ * fft_c_inverse
+ */
+void fft_c_inverse(const fft_c_plan *plan, int32 *real, int32 *imag)
+{
+    /* Swapping the real and imaginary parts on the way in and out turns
+     * the forward transform into the inverse one */
+    fft_c_run(plan, imag, real, TRUE);
+}
+
+/*
+ * fft_c_real_forward
+ */
+void fft_c_real_forward(const fft_c_plan *plan, const int32 *input,
+                        int32 *real, int32 *imag)
+{
+    unsigned half = plan->num_points;
+    unsigned k;
+
+    /* Even samples as the real parts, odd samples as the imaginary parts */
+    for (k = 0; k < half; k++)
+    {
+        real[k] = input[2 * k];
+        imag[k] = input[2 * k + 1];
+    }
+    fft_c_run(plan, real, imag, FALSE);
+
+    /* Bins 0 and N/2 */
+    {
+        int32 zr = real[0], zi = imag[0];
+
+        real[0] = zr + zi;
+        imag[0] = zr - zi;
+    }
+
+    /* Bins k and N/2-k together from Z[k] and Z[N/2-k]:
+     * E = (Z[k] + conj(Z[N/2-k])) / 2, O = -i * (Z[k] - conj(Z[N/2-k])) / 2,
+     * X[k] = E + W^k * O, X[N/2-k] = conj(E - W^k * O) */
+    for (k = 1; k <= half / 2; k++)
+    {
+        unsigned m = half - k;
+        int32 e_re = (int32)(((int64)real[k] + real[m]) >> 1);
+        int32 e_im = (int32)(((int64)imag[k] - imag[m]) >> 1);
+        int32 o_re = (int32)(((int64)imag[k] + imag[m]) >> 1);
+        int32 o_im = (int32)(((int64)real[m] - real[k]) >> 1);
+
+        fft_c_cmul(&o_re, &o_im, plan->split_real[k], plan->split_imag[k]);
+        real[k] = e_re + o_re;
+        imag[k] = e_im + o_im;
+        if (m != k)
+        {
+            real[m] = e_re - o_re;
+            imag[m] = o_im - e_im;
+        }
+    }
+}
+
+/*
+ * fft_c_real_inverse
+ */
+void fft_c_real_inverse(const fft_c_plan *plan, int32 *real, int32 *imag,
+                        int32 *output)
+{
+    unsigned half = plan->num_points;
+    unsigned k;
+
+    /* Bins 0 and N/2 */
+    {
+        int32 x0 = real[0], xn = imag[0];
+
+        real[0] = (int32)(((int64)x0 + xn) >> 1);
+        imag[0] = (int32)(((int64)x0 - xn) >> 1);
+    }
+
+    /* Undo the split: E = (X[k] + conj(X[N/2-k])) / 2,
+     * O = conj(W^k) * (X[k] - conj(X[N/2-k])) / 2,
+     * Z[k] = E + i*O, Z[N/2-k] = conj(E) + i*conj(O) */
+    for (k = 1; k <= half / 2; k++)
+    {
+        unsigned m = half - k;
+        int32 e_re = (int32)(((int64)real[k] + real[m]) >> 1);
+        int32 e_im = (int32)(((int64)imag[k] - imag[m]) >> 1);
+        int32 o_re = (int32)(((int64)real[k] - real[m]) >> 1);
+        int32 o_im = (int32)(((int64)imag[k] + imag[m]) >> 1);
+
+        fft_c_cmul(&o_re, &o_im, plan->split_real[k], -plan->split_imag[k]);
+        real[k] = e_re - o_im;
+        imag[k] = e_im + o_re;
+        if (m != k)
+        {
+            real[m] = e_re + o_im;
+            imag[m] = o_re - e_im;
+        }
+    }
+
+    fft_c_inverse(plan, real, imag);
+    for (k = 0; k < half; k++)
+    {
+        output[2 * k] = real[k];
+        output[2 * k + 1] = imag[k];
+    }
+}
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+****************************************************************************/
+/**
+ * \file fft_c.h
+ * \ingroup math
+ *
+ * Portable mixed-radix FFT. <br>
+ *
+ * Transforms any length from FFT_C_MIN_POINTS to FFT_C_MAX_POINTS that
+ * factors into 2, 3 and 5, using radix-4, 2, 3 and 5 stages. Data is Q31
+ * with the real and imaginary parts in separate buffers, as for $math.fft,
+ * but the output is in natural order rather than bit reversed.
+ *
+ * The twiddle factors are computed when a plan is created, for the length
+ * of that plan only, so there is no static twiddle table to link in.
+ *
+ * A real-input transform of N points runs as a complex transform of N/2
+ * points followed by a split step, for about half the work of a complex
+ * transform of N points.
+ *
+ * Scaling follows $math.fft and $math.ifft: the forward transform isn't
+ * scaled, so the input needs log2(N) bits of headroom, and the inverse is
+ * scaled by 1/N, one stage at a time.
+ */
+
+#ifndef _FFT_C_H_
+#define _FFT_C_H_
+/****************************************************************************
+Include Files
+*/
+
+#include "types.h"
+
+/****************************************************************************
+Public Constant Declarations
+*/
+
+/** Supported range of transform lengths, in complex points */
+#define FFT_C_MIN_POINTS        2
+#define FFT_C_MAX_POINTS        8192
+
+/** Largest number of stages, enough for FFT_C_MAX_POINTS in radix-2 */
+#define FFT_C_MAX_STAGES        13
+
+/****************************************************************************
+Public Type Declarations
+*/
+
+/** FFT plan */
+typedef struct fft_c_plan
+{
+    /** Number of complex points */
+    unsigned num_points;
+    /** Number of stages and the radix of each */
+    unsigned num_stages;
+    unsigned radix[FFT_C_MAX_STAGES];
+
+    /** exp(-2*pi*i*k/num_points), k = 0 .. num_points-1, Q31 */
+    int32 *twiddle_real;
+    int32 *twiddle_imag;
+    /** Work buffers, num_points words each */
+    int32 *work_real;
+    int32 *work_imag;
+
+    /** For a real-input plan, exp(-2*pi*i*k/(2*num_points)),
+     *  k = 0 .. num_points/2, Q31. NULL for a complex plan. */
+    int32 *split_real;
+    int32 *split_imag;
+} fft_c_plan;
+
+/****************************************************************************
+Public Function Declarations
+*/
+
+/**
+ * \brief Create a plan for a complex transform.
+ *
+ * \param num_points Number of complex points, a product of 2, 3 and 5
+ *        from FFT_C_MIN_POINTS to FFT_C_MAX_POINTS
+ *
+ * \return Pointer to the new plan, NULL if the length isn't supported or
+ *         there wasn't enough memory
+ */
+extern fft_c_plan *fft_c_create(unsigned num_points);
+
+/**
+ * \brief Create a plan for a real-input transform.
+ *
+ * \param num_points Number of real points, twice a length fft_c_create
+ *        supports
+ *
+ * \return Pointer to the new plan, NULL if the length isn't supported or
+ *         there wasn't enough memory
+ */
+extern fft_c_plan *fft_c_create_real(unsigned num_points);
+
+/**
+ * \brief Destroy a plan.
+ *
+ * \param plan The plan to destroy, may be NULL
+ */
+extern void fft_c_destroy(fft_c_plan *plan);
+
+/**
+ * \brief Generate one twiddle factor.
+ *
+ * \param k Index of the factor, 0 to n-1
+ * \param n Number of factors in a full turn
+ * \param cos_val Receives cos(2*pi*k/n), Q31, saturated at 1.0
+ * \param sin_val Receives sin(2*pi*k/n), Q31, saturated at 1.0
+ */
+extern void fft_c_twiddle(unsigned k, unsigned n, int32 *cos_val, int32 *sin_val);
+
+/**
+ * \brief Complex forward transform, in place.
+ *
+ * \param plan A complex plan
+ * \param real Real parts, num_points words
+ * \param imag Imaginary parts, num_points words
+ */
+extern void fft_c_forward(const fft_c_plan *plan, int32 *real, int32 *imag);
+
+/**
+ * \brief Complex inverse transform, in place, scaled by 1/num_points.
+ *
+ * \param plan A complex plan
+ * \param real Real parts, num_points words
+ * \param imag Imaginary parts, num_points words
+ */
+extern void fft_c_inverse(const fft_c_plan *plan, int32 *real, int32 *imag);
+
+/**
+ * \brief Real-input forward transform.
+ *
+ * Bins 0 to N/2-1 of the N point spectrum are written. The imaginary parts
+ * of bins 0 and N/2 are always zero, so imag[0] holds the real part of bin
+ * N/2 instead.
+ *
+ * \param plan A real-input plan of N points
+ * \param input N real samples, unchanged
+ * \param real Receives the real parts, N/2 words
+ * \param imag Receives the imaginary parts, N/2 words
+ */
+extern void fft_c_real_forward(const fft_c_plan *plan, const int32 *input,
+                               int32 *real, int32 *imag);
+
+/**
+ * \brief Real-output inverse transform, scaled by 1/N.
+ *
+ * \param plan A real-input plan of N points
+ * \param real Real parts, N/2 words, packed as by fft_c_real_forward.
+ *        Trashed.
+ * \param imag Imaginary parts, N/2 words. Trashed.
+ * \param output Receives N real samples
+ */
+extern void fft_c_real_inverse(const fft_c_plan *plan, int32 *real, int32 *imag,
+                               int32 *output);
+
+#endif /* _FFT_C_H_ */